@@ -0,0 +1,182 @@
+// Reproduce en Linux una captura hecha con adcRecord.c.
+// Mapea el archivo con mmap y pasa los bloques por la misma FIR y FFT que
+// corren en la placa, tan rápido como se pueda, y reporta el throughput y
+// un checksum de la salida (sirve como entrada de regresión determinista):
+// FNV-1a de los bits de todos los bins de cada FFT, así cualquier cambio en
+// la FIR o la FFT lo mueve.
+//
+//   gcc -O2 -Imain host/adcReplay.c main/adcCapture.c main/dspArena.c main/filterKernels.c main/fftPlan.c -lm -o adcReplay
+//   ./adcReplay captura.bin [repeticiones] [canal]
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "adcCapture.h"
+#include "dspArena.h"
+#include "filterKernels.h"
+#include "fftPlan.h"
+
+// -------------------- FIR y FFT (los mismos kernels que en la placa) --------------------
+#define FIR_ORDER 6
+#define N_FFT 64
+
+// Coeficientes de filterFIR.c
+static const float fir_coeffs[FIR_ORDER] = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
+
+static uint8_t dsp_arena_buffer[4096] __attribute__((aligned(16)));
+// -------------------- FIR y FFT --------------------
+
+// FNV-1a de 64 bits
+#define FNV_OFFSET 0xcbf29ce484222325ull
+#define FNV_PRIME  0x100000001b3ull
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++)
+        hash = (hash ^ p[i]) * FNV_PRIME;
+    return hash;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// La captura puede venir con texto de log delante (volcado por la consola)
+static long find_capture(const uint8_t *data, size_t size)
+{
+    uint32_t magic = ADC_CAPTURE_MAGIC;
+    for (size_t i = 0; i + sizeof(adc_capture_header_t) <= size; i++) {
+        if (memcmp(data + i, &magic, sizeof(magic)) == 0)
+            return (long)i;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s captura.bin [repeticiones] [canal]\n", argv[0]);
+        return 1;
+    }
+    int iterations = argc > 2 ? atoi(argv[2]) : 100;
+    int channel_pos = argc > 3 ? atoi(argv[3]) : 0;
+
+    int fd = open(argv[1], O_RDONLY);
+    if (fd < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror(argv[1]);
+        close(fd);
+        return 1;
+    }
+    const uint8_t *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    long start = find_capture(map, st.st_size);
+    // Con texto delante la captura puede quedar desalineada: se copia
+    const uint8_t *capture = map + (start < 0 ? 0 : start);
+    uint8_t *aligned = NULL;
+    if (start >= 0 && ((uintptr_t)capture % 4) != 0) {
+        aligned = malloc(st.st_size - start);
+        if (!aligned) {
+            perror("malloc");
+            return 1;
+        }
+        memcpy(aligned, capture, st.st_size - start);
+        capture = aligned;
+    }
+    adc_capture_reader_t reader;
+    if (start < 0 || adc_capture_reader_open(&reader, capture, st.st_size - start) != 0) {
+        fprintf(stderr, "%s: no es una captura válida\n", argv[1]);
+        return 1;
+    }
+    const adc_capture_header_t *h = reader.header;
+    if (channel_pos >= h->num_channels) {
+        fprintf(stderr, "canal %d fuera de rango (%u canales)\n", channel_pos, h->num_channels);
+        return 1;
+    }
+    printf("captura: %u Hz, %u canales, %u bits, %s, bloques de %u muestras\n",
+           (unsigned)h->sample_rate_hz, h->num_channels, h->bit_width,
+           h->format == ADC_CAPTURE_PACKED12 ? "packed12" : "int16",
+           (unsigned)h->block_samples);
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    fir_state_t *fir = fir_create(&arena, fir_coeffs, FIR_ORDER);
+    fft_plan_t *plan = fft_plan_create(&arena, N_FFT);
+    float *fft_data = dsp_arena_alloc_floats(&arena, 2 * N_FFT, "fft_data");
+    if (!fir || !plan || !fft_data) {
+        dsp_arena_report(&arena, "adcReplay");
+        return 1;
+    }
+
+    // Sólo hace falta copiar si el payload viene empaquetado
+    uint16_t *unpacked = malloc(h->block_samples * sizeof(uint16_t));
+    int count = 0;
+    uint64_t checksum = FNV_OFFSET;
+    uint64_t samples = 0;
+    int truncated = 0;
+
+    double t0 = now_s();
+    for (int it = 0; it < iterations; it++) {
+        adc_capture_block_t block;
+        int r;
+        adc_capture_reader_rewind(&reader);
+        while ((r = adc_capture_reader_next(&reader, &block)) == 1) {
+            const uint16_t *codes;
+            if (h->format == ADC_CAPTURE_PACKED12) {
+                adc_capture_unpack12(block.payload, unpacked, block.num_samples);
+                codes = unpacked;
+            } else {
+                codes = (const uint16_t *)block.payload;
+            }
+
+            for (uint32_t i = channel_pos; i < block.num_samples; i += h->num_channels) {
+                float normalized_sample = (float)codes[i] / 4095.0f;
+                float filtered_sample = fir_filter(fir, normalized_sample);
+
+                fft_data[2 * count] = filtered_sample;
+                fft_data[2 * count + 1] = 0.0f;
+                if (++count == N_FFT) {
+                    fft_plan_forward(plan, fft_data);
+                    checksum = fnv1a(checksum, fft_data, 2 * N_FFT * sizeof(float));
+                    count = 0;
+                }
+                samples++;
+            }
+        }
+        if (r < 0)
+            truncated = 1;
+    }
+    double elapsed = now_s() - t0;
+
+    if (truncated)
+        fprintf(stderr, "aviso: la captura está truncada o dañada, se ignoró desde el bloque inválido\n");
+    printf("%llu muestras en %.3f s: %.2f Msps, %.1f ns/muestra\n",
+           (unsigned long long)samples, elapsed, samples / elapsed * 1e-6,
+           elapsed * 1e9 / (samples ? samples : 1));
+    printf("checksum: %016llx\n", (unsigned long long)checksum);
+
+    free(unpacked);
+    free(aligned);
+    munmap((void *)map, st.st_size);
+    return 0;
+}
@@ -0,0 +1,230 @@
+// Modo de medición de latencia (latencyProbe.h) contra un ADC y un DAC
+// simulados en el host. Un hilo hace de ADC: cada marco de bytes_por_marco
+// (ADC_FRAME_SIZE de filterFIR.c: conversiones de ADC_RESULT_BYTES que
+// alternan entre ADC_CHANNELS canales a fs_hz en total) espera su instante
+// real, llama al "callback" y lo deja en un pool de ADC_BUFFER_SIZE bytes
+// (max_store_buf_size del driver); si está lleno el marco se pierde y se
+// avisa como on_pool_ovf. El hilo principal duerme en una variable de
+// condición hasta que hay un marco en el pool y lo vacía: por cada marco lee
+// el más viejo, filtra con fir_filter las muestras del primer canal y las
+// escribe al DAC simulado. A diferencia de filterFIR.c (un marco por flag),
+// los flags que se juntan no dejan marcos encolados para siempre.
+//
+//   gcc -O2 -Imain host/latencySim.c main/latencyProbe.c main/dspArena.c main/filterKernels.c -lm -pthread -o latencySim
+//   ./latencySim [fs_hz] [bytes_por_marco] [segundos] [carga_us]
+//
+// carga_us agrega trabajo por bloque para ver los fuera de plazo y la cola.
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "latencyProbe.h"
+#include "dspArena.h"
+#include "filterKernels.h"
+
+#define ADC_BUFFER_SIZE     1024    // como en filterFIR.c
+#define ADC_RESULT_BYTES    2       // SOC_ADC_DIGI_RESULT_BYTES del ESP32
+#define ADC_CHANNELS        2
+#define ADC_MAX_FRAME       (ADC_BUFFER_SIZE / 2)   // bytes: al menos dos marcos en el pool
+#define IMPULSE_PERIOD      100     // bloques
+#define REPORT_SECONDS      1
+
+// -------------------- FIR --------------------
+#define FIR_ORDER 6
+// Coeficientes de filterFIR.c
+static const float fir_coeffs[FIR_ORDER] = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
+
+static uint8_t dsp_arena_buffer[256] __attribute__((aligned(16)));
+// -------------------- FIR --------------------
+
+static latency_probe_t probe;
+
+// -------------------- ADC Y DAC SIMULADOS --------------------
+static int adc_fs_hz = 50000;
+static int adc_frame_bytes = 4;
+static int adc_frame;               // conversiones por marco
+static int adc_pool_frames;
+static uint16_t adc_pool[ADC_BUFFER_SIZE / ADC_RESULT_BYTES];
+static atomic_uint adc_written;     // marcos escritos en el pool
+static atomic_uint adc_read;        // marcos leídos por el lazo
+static atomic_int adc_running = 1;
+static pthread_mutex_t adc_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t adc_ready = PTHREAD_COND_INITIALIZER;   // hay marcos en el pool
+static atomic_uint adc_dropped;
+
+static uint64_t dac_writes;
+static uint8_t dac_last;
+
+static void timespec_add_ns(struct timespec *t, long ns)
+{
+    t->tv_nsec += ns;
+    while (t->tv_nsec >= 1000000000L) {
+        t->tv_nsec -= 1000000000L;
+        t->tv_sec++;
+    }
+}
+
+// Entrada quieta (media escala con un poco de ruido) para que el impulso se vea
+static void *adc_thread(void *arg)
+{
+    (void)arg;
+    uint32_t seed = 1;
+    long frame_ns = (long)(1e9 * adc_frame / adc_fs_hz);
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (atomic_load(&adc_running)) {
+        timespec_add_ns(&next, frame_ns);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        // Como el driver: on_conv_done antes de encolar, on_pool_ovf si no entra
+        latency_probe_isr(&probe);
+
+        unsigned w = atomic_load(&adc_written);
+        if (w - atomic_load(&adc_read) == (unsigned)adc_pool_frames) {
+            latency_probe_isr_dropped(&probe);
+            atomic_fetch_add(&adc_dropped, 1);
+            continue;
+        }
+        uint16_t *frame = &adc_pool[(w % adc_pool_frames) * adc_frame];
+        for (int i = 0; i < adc_frame; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            frame[i] = 2048 + (seed >> 29);
+        }
+        atomic_store(&adc_written, w + 1);
+
+        // Con el lock: el lazo no puede perder el aviso entre mirar y dormir
+        pthread_mutex_lock(&adc_lock);
+        pthread_cond_signal(&adc_ready);
+        pthread_mutex_unlock(&adc_lock);
+    }
+    return NULL;
+}
+
+// adc_continuous_read: el marco más viejo del pool, 0 si no hay
+static int sim_adc_read(uint16_t *out)
+{
+    unsigned r = atomic_load(&adc_read);
+    if (r == atomic_load(&adc_written))
+        return 0;
+    const uint16_t *frame = &adc_pool[(r % adc_pool_frames) * adc_frame];
+    for (int i = 0; i < adc_frame; i++)
+        out[i] = frame[i];
+    atomic_store(&adc_read, r + 1);
+    return adc_frame;
+}
+
+static void sim_dac_write(uint8_t value)
+{
+    dac_last = value;
+    dac_writes++;
+}
+// -------------------- ADC Y DAC SIMULADOS --------------------
+
+static void busy_wait_us(double us)
+{
+    uint32_t t0 = latency_now();
+    while (latency_now() - t0 < us * LATENCY_TICKS_PER_US)
+        ;
+}
+
+int main(int argc, char **argv)
+{
+    adc_fs_hz = argc > 1 ? atoi(argv[1]) : 50000;
+    adc_frame_bytes = argc > 2 ? atoi(argv[2]) : 4;
+    int seconds = argc > 3 ? atoi(argv[3]) : 3;
+    double load_us = argc > 4 ? atof(argv[4]) : 0.0;
+    // Marcos de conversiones enteras que arrancan siempre en el primer canal
+    if (adc_fs_hz <= 0 || adc_frame_bytes <= 0 || adc_frame_bytes > ADC_MAX_FRAME ||
+        adc_frame_bytes % (ADC_RESULT_BYTES * ADC_CHANNELS) || seconds <= 0) {
+        fprintf(stderr, "uso: %s [fs_hz] [bytes_por_marco, múltiplo de %d hasta %d] [segundos] [carga_us]\n",
+                argv[0], ADC_RESULT_BYTES * ADC_CHANNELS, ADC_MAX_FRAME);
+        return 1;
+    }
+    adc_frame = adc_frame_bytes / ADC_RESULT_BYTES;
+    adc_pool_frames = ADC_BUFFER_SIZE / adc_frame_bytes;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    fir_state_t *fir = fir_create(&arena, fir_coeffs, FIR_ORDER);
+    if (!fir)
+        return 1;
+
+    // Mismo plazo que filterFIR.c: ADC_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES conversiones
+    latency_probe_init(&probe, 1e6f * adc_frame / adc_fs_hz, 0.0f);
+    int st_read = latency_probe_add_stage(&probe, "lectura");
+    int st_fir = latency_probe_add_stage(&probe, "fir");
+    int st_dac = latency_probe_add_stage(&probe, "dac");
+    latency_probe_set_impulse(&probe, IMPULSE_PERIOD, 1.0f, 0.1f);
+
+    printf("fs %d Hz, marcos de %d bytes (%d conversiones, pool de %d marcos), %d s, carga %.1f us por bloque\n",
+           adc_fs_hz, adc_frame_bytes, adc_frame, adc_pool_frames, seconds, load_us);
+
+    pthread_t adc;
+    pthread_create(&adc, NULL, adc_thread, NULL);
+
+    uint16_t codes[ADC_MAX_FRAME];
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int reports = 0;
+
+    while (reports < seconds) {
+        // Sin marcos en el pool se duerme (en la placa, la tarea espera el flag)
+        pthread_mutex_lock(&adc_lock);
+        while (atomic_load(&adc_read) == atomic_load(&adc_written))
+            pthread_cond_wait(&adc_ready, &adc_lock);
+        pthread_mutex_unlock(&adc_lock);
+
+        // Se vacía el pool: un bloque por marco, del más viejo al más nuevo.
+        // Sólo este hilo lee, así que los marcos que se ven no desaparecen.
+        while (atomic_load(&adc_read) != atomic_load(&adc_written)) {
+            latency_probe_begin(&probe);
+            int n = sim_adc_read(codes);
+            latency_probe_stage(&probe, st_read);
+
+            // Sólo el primer canal, como filterFIR.c
+            float out[ADC_MAX_FRAME];
+            int samples = 0;
+            for (int i = 0; i < n; i += ADC_CHANNELS) {
+                float normalized_sample = (float)codes[i] / 4095.0f;
+                if (i == 0)
+                    normalized_sample = latency_probe_inject(&probe, normalized_sample);
+                out[samples++] = fir_filter(fir, normalized_sample);
+            }
+            if (load_us > 0.0)
+                busy_wait_us(load_us);
+            latency_probe_stage(&probe, st_fir);
+
+            for (int i = 0; i < samples; i++) {
+                float y = out[i];
+                if (y < 0.0f) y = 0.0f;
+                if (y > 1.0f) y = 1.0f;
+                latency_probe_output(&probe, y);
+                sim_dac_write((uint8_t)(y * 255.0f));
+            }
+            latency_probe_stage(&probe, st_dac);
+            latency_probe_end(&probe);
+
+            // Con sobrecarga el pool no se vacía nunca: el reporte va por bloque
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (now.tv_sec - start.tv_sec >= reports + REPORT_SECONDS) {
+                reports++;
+                latency_probe_report(&probe, "latencySim");
+                printf("pool lleno: %u marcos perdidos, %llu escrituras al DAC (última %u)\n\n",
+                       atomic_load(&adc_dropped), (unsigned long long)dac_writes, dac_last);
+                latency_probe_reset(&probe);
+                if (reports == seconds)
+                    break;
+            }
+        }
+    }
+
+    atomic_store(&adc_running, 0);
+    pthread_join(adc, NULL);
+    return 0;
+}
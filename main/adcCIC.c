@@ -0,0 +1,182 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+
+#include "cic.h"
+#include "filterKernels.h"
+
+// -------------------- CIC --------------------
+// Orden 4, R = 8: 12 + 4*3 = 24 bits a la salida del CIC. La FIR de
+// compensación aplana la caída hasta fs_out/4 (12.5 kHz).
+#define CIC_ORDER       4
+#define CIC_RATIO       8
+#define CIC_COMP_TAPS   15
+#define CIC_PASSBAND    0.5f
+// -------------------- CIC --------------------
+
+// El ADC corre CIC_RATIO veces más rápido que en filterFIR.c y el CIC baja
+// la tasa a ADC_OUTPUT_HZ antes de la FIR, con bits extra de resolución.
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             4096
+#define ADC_FRAME_SIZE              256     // 128 conversiones por lectura
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_OUTPUT_HZ               50000
+#define ADC_FRECUENCY_HZ            (ADC_OUTPUT_HZ * CIC_RATIO)
+
+#define DAC_CHAN                    DAC_CHAN_0
+#define LED_PIN GPIO_NUM_2
+
+static const char *TAG = "ADC_CIC";
+
+static adc_channel_t channel[1] = {ADC_CHANNEL_6};
+dac_oneshot_handle_t DAC_handle;
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+void dac_init(void)
+{
+    dac_oneshot_config_t dac_config = {
+        .chan_id = DAC_CHAN,
+    };
+    dac_oneshot_new_channel(&dac_config, &DAC_handle);
+}
+
+void init_gpio()
+{
+    // Configurar el GPIO como salida
+    gpio_config_t io_conf = {
+        .pin_bit_mask = (1ULL << LED_PIN),
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    gpio_config(&io_conf);
+}
+
+
+// -------------------- FIR --------------------
+// La misma FIR de filterFIR.c, ahora a ADC_OUTPUT_HZ
+#define FIR_ORDER 6
+const float fir_coeffs[FIR_ORDER] = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
+
+#define DSP_ARENA_SIZE 1024
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+// -------------------- FIR --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    cic_decimator_t *cic = cic_create(&arena, CIC_ORDER, CIC_RATIO, 12, CIC_COMP_TAPS, CIC_PASSBAND);
+    fir_state_t *fir = fir_create(&arena, fir_coeffs, FIR_ORDER);
+    dsp_arena_report(&arena, "adcCIC");
+    if (!cic || !fir)
+        return;
+
+    ESP_LOGI(TAG, "ADC a %d Hz, salida a %d Hz, %d bits a la salida del CIC",
+             ADC_FRECUENCY_HZ, ADC_OUTPUT_HZ, cic->output_bits);
+
+    dac_init();
+    continuous_adc_init();
+
+    //descomentar para medir el tiempo de CIC + FIR por marco
+    //init_gpio();
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+
+            //gpio_set_level(LED_PIN, 1);
+            for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[i];
+                if (ADC_GET_CHANNEL(p) != ADC_CHANNEL_6)
+                    continue;
+
+                // 1️⃣ Integradores a la tasa del ADC (sumas enteras)
+                float decimated;
+                if (!cic_push(cic, ADC_GET_DATA(p), &decimated))
+                    continue;
+
+                // 2️⃣ Normalizar a 0-1 (el CIC compensado da códigos con fracción)
+                float normalized_sample = decimated / 4095.0f;
+
+                // 3️⃣ Aplicar FIR a la tasa reducida
+                float filtered_sample = fir_filter(fir, normalized_sample);
+
+                // 4️⃣ Saturar
+                if (filtered_sample < 0.0f) filtered_sample = 0.0f;
+                if (filtered_sample > 1.0f) filtered_sample = 1.0f;
+
+                // 5️⃣ Escalar a DAC 0-255 (8 bits) y escribir
+                dac_oneshot_output_voltage(DAC_handle, (uint8_t)(filtered_sample * 255.0f));
+            }
+            //gpio_set_level(LED_PIN, 0);
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
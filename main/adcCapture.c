@@ -0,0 +1,203 @@
+#include <string.h>
+#include "adcCapture.h"
+
+size_t adc_capture_payload_size(adc_capture_format_t format, uint32_t num_samples)
+{
+    size_t bytes;
+    if (format == ADC_CAPTURE_PACKED12)
+        bytes = ((size_t)num_samples * 3 + 1) / 2;
+    else
+        bytes = (size_t)num_samples * sizeof(int16_t);
+
+    // Relleno a múltiplo de 4
+    return (bytes + 3) & ~(size_t)3;
+}
+
+// 2 muestras -> 3 bytes: [a7..a0] [b3..b0 a11..a8] [b11..b4]
+void adc_capture_pack12(const uint16_t *src, uint8_t *dst, uint32_t num_samples)
+{
+    uint32_t i = 0;
+    for (; i + 1 < num_samples; i += 2) {
+        uint16_t a = src[i] & 0x0FFF;
+        uint16_t b = src[i + 1] & 0x0FFF;
+        *dst++ = (uint8_t)a;
+        *dst++ = (uint8_t)((a >> 8) | (b << 4));
+        *dst++ = (uint8_t)(b >> 4);
+    }
+    // Muestra impar al final
+    if (i < num_samples) {
+        uint16_t a = src[i] & 0x0FFF;
+        *dst++ = (uint8_t)a;
+        *dst++ = (uint8_t)(a >> 8);
+    }
+}
+
+void adc_capture_unpack12(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    uint32_t i = 0;
+    for (; i + 1 < num_samples; i += 2) {
+        dst[i]     = (uint16_t)(src[0] | ((src[1] & 0x0F) << 8));
+        dst[i + 1] = (uint16_t)((src[1] >> 4) | (src[2] << 4));
+        src += 3;
+    }
+    if (i < num_samples)
+        dst[i] = (uint16_t)(src[0] | ((src[1] & 0x0F) << 8));
+}
+
+// -------------------- GRABADOR --------------------
+int adc_recorder_init(adc_recorder_t *rec, uint32_t sample_rate_hz,
+                      const uint8_t *channel_map, uint8_t num_channels,
+                      adc_capture_format_t format, uint32_t block_samples,
+                      uint16_t *block_buffer, uint8_t *payload_buffer,
+                      adc_capture_write_fn write, void *ctx)
+{
+    if (num_channels == 0 || num_channels > ADC_CAPTURE_MAX_CHANNELS)
+        return -1;
+    // Los bloques deben contener tramas completas (todas las ch)
+    if (block_samples == 0 || block_samples > UINT16_MAX || block_samples % num_channels)
+        return -1;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->header.magic = ADC_CAPTURE_MAGIC;
+    rec->header.version = ADC_CAPTURE_VERSION;
+    rec->header.header_size = sizeof(adc_capture_header_t);
+    rec->header.sample_rate_hz = sample_rate_hz;
+    rec->header.num_channels = num_channels;
+    rec->header.bit_width = 12;
+    rec->header.format = (uint8_t)format;
+    memcpy(rec->header.channel_map, channel_map, num_channels);
+    rec->header.block_samples = block_samples;
+
+    rec->write = write;
+    rec->ctx = ctx;
+    rec->block = block_buffer;
+    rec->payload = payload_buffer;
+
+    if (write(&rec->header, sizeof(rec->header), ctx) != sizeof(rec->header))
+        return -1;
+    return 0;
+}
+
+adc_recorder_t *adc_recorder_create(dsp_arena_t *arena, uint32_t sample_rate_hz,
+                                    const uint8_t *channel_map, uint8_t num_channels,
+                                    adc_capture_format_t format, uint32_t block_samples,
+                                    adc_capture_write_fn write, void *ctx)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    adc_recorder_t *rec = dsp_arena_alloc(arena, sizeof(*rec), 0, "adc_recorder");
+    uint16_t *block = dsp_arena_alloc(arena, block_samples * sizeof(uint16_t), 0, "adc_recorder");
+    uint8_t *payload = dsp_arena_alloc(arena, adc_capture_payload_size(format, block_samples),
+                                       0, "adc_recorder");
+    if (!rec || !block || !payload ||
+        adc_recorder_init(rec, sample_rate_hz, channel_map, num_channels, format, block_samples,
+                          block, payload, write, ctx) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return rec;
+}
+
+static int write_block(adc_recorder_t *rec)
+{
+    adc_capture_format_t format = (adc_capture_format_t)rec->header.format;
+    adc_capture_block_header_t bh = {
+        .seq = rec->seq,
+        .num_samples = (uint16_t)rec->fill,
+        .flags = 0,
+    };
+    size_t payload_size = adc_capture_payload_size(format, rec->fill);
+
+    if (format == ADC_CAPTURE_PACKED12) {
+        adc_capture_pack12(rec->block, rec->payload, rec->fill);
+    } else {
+        memcpy(rec->payload, rec->block, rec->fill * sizeof(int16_t));
+    }
+    // Relleno determinista (la captura debe ser reproducible byte a byte)
+    size_t used = (format == ADC_CAPTURE_PACKED12) ? ((size_t)rec->fill * 3 + 1) / 2
+                                                   : (size_t)rec->fill * sizeof(int16_t);
+    memset(rec->payload + used, 0, payload_size - used);
+
+    int ok = rec->write(&bh, sizeof(bh), rec->ctx) == sizeof(bh)
+          && rec->write(rec->payload, payload_size, rec->ctx) == payload_size;
+
+    if (!ok)
+        rec->dropped += rec->fill;
+    rec->seq++;
+    rec->fill = 0;
+    return ok ? 0 : -1;
+}
+
+int adc_recorder_push(adc_recorder_t *rec, uint16_t sample)
+{
+    rec->block[rec->fill++] = sample;
+    if (rec->fill == rec->header.block_samples)
+        return write_block(rec);
+    return 0;
+}
+
+int adc_recorder_flush(adc_recorder_t *rec)
+{
+    if (rec->fill == 0)
+        return 0;
+    return write_block(rec);
+}
+
+// -------------------- LECTOR --------------------
+int adc_capture_reader_open(adc_capture_reader_t *reader, const void *data, size_t size)
+{
+    const adc_capture_header_t *h = (const adc_capture_header_t *)data;
+
+    if (size < sizeof(*h) || h->magic != ADC_CAPTURE_MAGIC || h->version != ADC_CAPTURE_VERSION)
+        return -1;
+    if (h->header_size < sizeof(*h) || h->header_size > size)
+        return -1;
+    if (h->num_channels == 0 || h->num_channels > ADC_CAPTURE_MAX_CHANNELS)
+        return -1;
+    if (h->format != ADC_CAPTURE_PACKED12 && h->format != ADC_CAPTURE_INT16)
+        return -1;
+    if (h->block_samples == 0 || h->block_samples > UINT16_MAX)
+        return -1;
+    // Los payloads quedan alineados a 4 sólo si la cabecera también lo está;
+    // con INT16 el payload se usa como int16_t* sin copiar
+    if (h->header_size % 4 != 0)
+        return -1;
+    if (h->format == ADC_CAPTURE_INT16 && ((uintptr_t)data % sizeof(int16_t)) != 0)
+        return -1;
+
+    reader->base = (const uint8_t *)data;
+    reader->size = size;
+    reader->header = h;
+    reader->offset = h->header_size;
+    return 0;
+}
+
+int adc_capture_reader_next(adc_capture_reader_t *reader, adc_capture_block_t *block)
+{
+    if (reader->offset == reader->size)
+        return 0;
+    if (reader->size - reader->offset < sizeof(adc_capture_block_header_t))
+        return -1;
+
+    const adc_capture_block_header_t *bh =
+        (const adc_capture_block_header_t *)(reader->base + reader->offset);
+    // El lector entrega a lo sumo block_samples muestras (el buffer del llamador)
+    if (bh->num_samples > reader->header->block_samples)
+        return -1;
+    size_t payload_size = adc_capture_payload_size((adc_capture_format_t)reader->header->format,
+                                                   bh->num_samples);
+    size_t offset = reader->offset + sizeof(*bh);
+
+    if (reader->size - offset < payload_size)
+        return -1;
+
+    block->seq = bh->seq;
+    block->num_samples = bh->num_samples;
+    block->payload = reader->base + offset;
+    reader->offset = offset + payload_size;
+    return 1;
+}
+
+void adc_capture_reader_rewind(adc_capture_reader_t *reader)
+{
+    reader->offset = reader->header->header_size;
+}
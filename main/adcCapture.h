@@ -0,0 +1,110 @@
+#ifndef ADC_CAPTURE_H
+#define ADC_CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "dspArena.h"
+
+// -------------------- FORMATO DE CAPTURA ADC --------------------
+// Archivo = cabecera (32 bytes) + bloques. Cada bloque = cabecera de bloque
+// (8 bytes) + payload con las muestras intercaladas por canal
+// (ch0, ch1, ch0, ch1, ...). Todo en little-endian (ESP32 y x86 lo son).
+//
+// Payload:
+//  - ADC_CAPTURE_PACKED12: 2 muestras de 12 bits en 3 bytes.
+//  - ADC_CAPTURE_INT16:    1 muestra por int16 (se puede usar sin copiar).
+// El payload se rellena hasta múltiplo de 4 bytes para que el siguiente
+// bloque quede alineado.
+
+#define ADC_CAPTURE_MAGIC           0x43434441u   // "ADCC"
+#define ADC_CAPTURE_VERSION         1
+#define ADC_CAPTURE_MAX_CHANNELS    8
+
+typedef enum {
+    ADC_CAPTURE_PACKED12 = 0,
+    ADC_CAPTURE_INT16    = 1,
+} adc_capture_format_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t sample_rate_hz;                        // por canal
+    uint8_t  num_channels;
+    uint8_t  bit_width;                             // bits útiles del ADC (12)
+    uint8_t  format;                                // adc_capture_format_t
+    uint8_t  reserved0;
+    uint8_t  channel_map[ADC_CAPTURE_MAX_CHANNELS]; // canal ADC de cada posición
+    uint32_t block_samples;                         // muestras (todas las ch) por bloque
+    uint32_t reserved1;
+} adc_capture_header_t;
+
+typedef struct {
+    uint32_t seq;
+    uint16_t num_samples;                           // puede ser menor en el último bloque
+    uint16_t flags;
+} adc_capture_block_header_t;
+
+_Static_assert(sizeof(adc_capture_header_t) == 32, "cabecera de captura debe ser de 32 bytes");
+_Static_assert(sizeof(adc_capture_block_header_t) == 8, "cabecera de bloque debe ser de 8 bytes");
+
+// Bytes de payload para n muestras (con relleno a 4 bytes)
+size_t adc_capture_payload_size(adc_capture_format_t format, uint32_t num_samples);
+
+void adc_capture_pack12(const uint16_t *src, uint8_t *dst, uint32_t num_samples);
+void adc_capture_unpack12(const uint8_t *src, uint16_t *dst, uint32_t num_samples);
+
+// -------------------- GRABADOR --------------------
+// Sink de la cadena de procesamiento: acumula muestras crudas del ADC y
+// escribe bloques completos por medio de write_fn (UART, SPIFFS, RAM, ...).
+// Devuelve la cantidad de bytes escritos; si es menor que len es un error.
+typedef size_t (*adc_capture_write_fn)(const void *data, size_t len, void *ctx);
+
+typedef struct {
+    adc_capture_header_t header;
+    adc_capture_write_fn write;
+    void *ctx;
+    uint16_t *block;        // block_samples muestras (lo provee el llamador)
+    uint8_t *payload;       // adc_capture_payload_size() bytes (lo provee el llamador)
+    uint32_t fill;
+    uint32_t seq;
+    uint32_t dropped;       // muestras descartadas por errores de escritura
+} adc_recorder_t;
+
+// Escribe la cabecera del archivo. Devuelve 0 si OK, -1 si error.
+int adc_recorder_init(adc_recorder_t *rec, uint32_t sample_rate_hz,
+                      const uint8_t *channel_map, uint8_t num_channels,
+                      adc_capture_format_t format, uint32_t block_samples,
+                      uint16_t *block_buffer, uint8_t *payload_buffer,
+                      adc_capture_write_fn write, void *ctx);
+// Igual que adc_recorder_init pero con los buffers desde la arena. NULL si falla.
+adc_recorder_t *adc_recorder_create(dsp_arena_t *arena, uint32_t sample_rate_hz,
+                                    const uint8_t *channel_map, uint8_t num_channels,
+                                    adc_capture_format_t format, uint32_t block_samples,
+                                    adc_capture_write_fn write, void *ctx);
+int adc_recorder_push(adc_recorder_t *rec, uint16_t sample);
+int adc_recorder_flush(adc_recorder_t *rec);
+
+// -------------------- LECTOR --------------------
+// Recorre una captura completa ya en memoria (p.ej. mmap en el host) sin copiar.
+typedef struct {
+    const uint8_t *base;
+    size_t size;
+    size_t offset;
+    const adc_capture_header_t *header;
+} adc_capture_reader_t;
+
+typedef struct {
+    uint32_t seq;
+    uint32_t num_samples;
+    const void *payload;    // int16_t* para INT16, bytes empaquetados para PACKED12
+} adc_capture_block_t;
+
+// data debe estar alineado a 2 bytes para INT16 (el payload se lee como int16_t*)
+int adc_capture_reader_open(adc_capture_reader_t *reader, const void *data, size_t size);
+// Devuelve 1 si hay bloque, 0 al final del archivo, -1 si el archivo está
+// truncado o el bloque trae más de block_samples muestras
+int adc_capture_reader_next(adc_capture_reader_t *reader, adc_capture_block_t *block);
+void adc_capture_reader_rewind(adc_capture_reader_t *reader);
+
+#endif
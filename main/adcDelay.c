@@ -0,0 +1,165 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+
+#include "gccPhat.h"
+
+// Retardo entre ADC_CHANNEL_6 (x) y ADC_CHANNEL_7 (y) por GCC-PHAT, un
+// resultado por bloque de GCC_BLOCK pares.
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             4096
+#define ADC_FRAME_SIZE              256     // 64 pares ch6/ch7 por lectura
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            100000  // 50 kHz por canal
+#define ADC_CHANNEL_HZ              (ADC_FRECUENCY_HZ / 2)
+
+// ch7 se convierte medio período de canal después que ch6, así que una misma
+// señal en los dos aparece con lag -0.5; se corrige antes de reportar.
+#define ADC_PAIR_SKEW               0.5f
+
+static const char *TAG = "ADC_DELAY";
+
+static adc_channel_t channel[2] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+
+// -------------------- GCC-PHAT --------------------
+#define GCC_BLOCK           256     // ~5 ms por estimación a 50 kHz
+#define GCC_MAX_LAG         32
+#define GCC_MIN_CONFIDENCE  0.2f    // por debajo no se reporta
+#define GCC_REPORT_BLOCKS   50      // un log cada ~0.25 s
+
+#define DSP_ARENA_SIZE (8 * 1024)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
+static float block_x[GCC_BLOCK];
+static float block_y[GCC_BLOCK];
+// -------------------- GCC-PHAT --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    gcc_phat_t *gcc = gcc_phat_create(&arena, GCC_BLOCK, GCC_MAX_LAG);
+    dsp_arena_report(&arena, "adcDelay");
+    if (!gcc)
+        return;
+
+    continuous_adc_init();
+
+    float ch6 = 0.0f;
+    int have_ch6 = 0;
+    int fill = 0;
+    int blocks = 0;
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+
+            for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[i];
+                float sample = (float)ADC_GET_DATA(p) / 4095.0f;
+
+                // 1️⃣ Armar los bloques con pares ch6/ch7
+                if (ADC_GET_CHANNEL(p) == ADC_CHANNEL_6) {
+                    ch6 = sample;
+                    have_ch6 = 1;
+                    continue;
+                }
+                if (ADC_GET_CHANNEL(p) != ADC_CHANNEL_7 || !have_ch6)
+                    continue;
+                have_ch6 = 0;
+                block_x[fill] = ch6;
+                block_y[fill] = sample;
+                if (++fill < GCC_BLOCK)
+                    continue;
+                fill = 0;
+
+                // 2️⃣ Estimar el retardo del bloque
+                gcc_phat_result_t r;
+                gcc_phat_estimate(gcc, block_x, block_y, &r);
+
+                // 3️⃣ Reportar
+                if (++blocks == GCC_REPORT_BLOCKS) {
+                    blocks = 0;
+                    if (r.confidence >= GCC_MIN_CONFIDENCE) {
+                        float lag = r.lag + ADC_PAIR_SKEW;
+                        ESP_LOGI(TAG, "lag %.2f muestras (%.1f us), confianza %.2f",
+                                 lag, lag * 1e6f / ADC_CHANNEL_HZ, r.confidence);
+                    } else {
+                        ESP_LOGI(TAG, "sin correlación (confianza %.2f)", r.confidence);
+                    }
+                }
+            }
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
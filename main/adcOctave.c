@@ -0,0 +1,139 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+
+#include "octaveBank.h"
+
+// Niveles por tercio de octava (o por octava) de ADC_CHANNEL_6, un reporte
+// por ventana de OCTAVE_WINDOW_S segundos.
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             4096
+#define ADC_FRAME_SIZE              256     // 128 muestras por lectura
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            50000
+
+static const char *TAG = "ADC_OCTAVE";
+
+static adc_channel_t channel[1] = {ADC_CHANNEL_6};
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+
+// -------------------- BANCO DE OCTAVAS --------------------
+// Tercios: centros 1000 * 2^(k/3) desde 10 kHz hasta 12.5 Hz (30 bandas).
+// Octavas: OCTAVE_FRACTION 1 y OCTAVE_TOP_HZ 8000 (8 kHz a 16 Hz).
+#define OCTAVE_FRACTION     3
+#define OCTAVE_TOP_HZ       10079.37f
+#define OCTAVE_OCTAVES      10
+#define OCTAVE_WINDOW_S     0.5f
+#define OCTAVE_REF          0.5f    // 0 dB = seno de media escala
+
+#define DSP_ARENA_SIZE (8 * 1024 + 1024)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
+static float block[ADC_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES];
+// -------------------- BANCO DE OCTAVAS --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    octave_bank_t *bank = octave_bank_create(&arena, ADC_FRECUENCY_HZ, OCTAVE_TOP_HZ, OCTAVE_OCTAVES,
+                                             OCTAVE_FRACTION, (uint32_t)(OCTAVE_WINDOW_S * ADC_FRECUENCY_HZ));
+    dsp_arena_report(&arena, "adcOctave");
+    if (!bank)
+        return;
+
+    continuous_adc_init();
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+
+            // 1️⃣ Normalizar a -1..1 (sin la media escala)
+            int n = 0;
+            for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[i];
+                if (ADC_GET_CHANNEL(p) == ADC_CHANNEL_6)
+                    block[n++] = (float)ADC_GET_DATA(p) / 2047.5f - 1.0f;
+            }
+
+            // 2️⃣ Filtrar e integrar
+            if (!octave_bank_process(bank, block, n))
+                continue;
+
+            // 3️⃣ Reportar los niveles de la ventana
+            ESP_LOGI(TAG, "niveles (dB respecto de media escala)");
+            for (int b = 0; b < bank->num_bands; b++)
+                printf("%8.1f Hz %6.1f dB\n", bank->center_hz[b], octave_bank_level_db(bank, b, OCTAVE_REF));
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
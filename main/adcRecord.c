@@ -0,0 +1,175 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "driver/uart.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+
+#include "adcCapture.h"
+
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             1024
+#define ADC_FRAME_SIZE              4
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            50000
+
+#define NUM_CHANNELS                2
+#define CAPTURE_FORMAT              ADC_CAPTURE_PACKED12
+#define CAPTURE_BLOCK_SAMPLES       512     // muestras intercaladas por bloque
+#define CAPTURE_BLOCKS              64      // ~50 KB en RAM con PACKED12
+#define CAPTURE_UART                CONFIG_ESP_CONSOLE_UART_NUM
+
+static const char *TAG = "ADC_RECORD";
+
+static adc_channel_t channel[NUM_CHANNELS] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+// -------------------- SINK EN RAM --------------------
+// La UART a 115200 baudios no llega a 150 KB/s, así que se graba primero en RAM
+// y se vuelca al final. Para capturas largas cambiar write_fn por un FILE* en SPIFFS/SD.
+#define CAPTURE_BYTES (sizeof(adc_capture_header_t) + CAPTURE_BLOCKS * \
+    (sizeof(adc_capture_block_header_t) + ((CAPTURE_BLOCK_SAMPLES * 3 + 1) / 2 + 3) / 4 * 4))
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+} mem_sink_t;
+
+static uint8_t capture_mem[CAPTURE_BYTES];
+
+// Buffers del grabador
+#define DSP_ARENA_SIZE (CAPTURE_BLOCK_SAMPLES * 2 * sizeof(int16_t) + 256)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
+static size_t mem_sink_write(const void *data, size_t len, void *ctx)
+{
+    mem_sink_t *sink = (mem_sink_t *)ctx;
+    if (sink->size - sink->len < len)
+        return 0;
+    memcpy(sink->buf + sink->len, data, len);
+    sink->len += len;
+    return len;
+}
+// -------------------- SINK EN RAM --------------------
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    mem_sink_t sink = {
+        .buf = capture_mem,
+        .size = sizeof(capture_mem),
+        .len = 0,
+    };
+    uint8_t channel_map[NUM_CHANNELS] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+
+    // ADC_FRECUENCY_HZ es el total del patrón; la cabecera lleva la tasa por canal
+    adc_recorder_t *recorder = adc_recorder_create(&arena, ADC_FRECUENCY_HZ / NUM_CHANNELS,
+                                                   channel_map, NUM_CHANNELS,
+                                                   CAPTURE_FORMAT, CAPTURE_BLOCK_SAMPLES,
+                                                   mem_sink_write, &sink);
+    dsp_arena_report(&arena, "adcRecord");
+    if (!recorder)
+        return;
+    continuous_adc_init();
+
+    int next_channel = 0;
+
+    while (recorder->seq < CAPTURE_BLOCKS)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+
+            for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[i];
+
+                // Mantener el orden ch6, ch7, ... aunque se pierda alguna conversión
+                if (ADC_GET_CHANNEL(p) != channel_map[next_channel])
+                    continue;
+                next_channel = (next_channel + 1) % NUM_CHANNELS;
+
+                adc_recorder_push(recorder, ADC_GET_DATA(p));
+            }
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+
+    ESP_LOGI(TAG, "Captura: %u bloques, %u bytes, %u muestras perdidas",
+             (unsigned)recorder->seq, (unsigned)sink.len, (unsigned)recorder->dropped);
+
+    // Volcar la captura cruda por la UART de la consola (host: leer el puerto
+    // serie a un archivo). No se usa stdout: con LINE_ENDING_CRLF newlib mete
+    // un 0x0D antes de cada 0x0A y rompe el binario. El driver escribe los
+    // bytes tal cual; el log de arranque queda delante y adcReplay lo saltea
+    // buscando la cabecera.
+    fflush(stdout);
+    vTaskDelay(pdMS_TO_TICKS(100));
+    ESP_ERROR_CHECK(uart_driver_install(CAPTURE_UART, 2 * SOC_UART_FIFO_LEN, 0, 0, NULL, 0));
+    uart_write_bytes(CAPTURE_UART, sink.buf, sink.len);
+    ESP_ERROR_CHECK(uart_wait_tx_done(CAPTURE_UART, portMAX_DELAY));
+}
@@ -0,0 +1,181 @@
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include "chirpZ.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static int conv_size(int n_in, int m_out)
+{
+    int L = 2;
+    while (L < n_in + m_out - 1)
+        L *= 2;
+    return L;
+}
+
+size_t czt_workspace_size(int n_in, int m_out)
+{
+    size_t L = conv_size(n_in, m_out);
+    return FFT_PLAN_TWIDDLE_SIZE(L) + 2 * (size_t)n_in + 2 * (size_t)m_out + 2 * L + 2 * L;
+}
+
+// Fase de W^(m^2/2) = e^(-i*pi*step*m^2), reducida a menos de una vuelta.
+// m^2 se calcula en entero de 64 bits (con long de 32 bits en el ESP32
+// desbordaba desde m = 46341) y es exacto en double hasta 2^53. El producto
+// por step/2 se separa en el valor redondeado y su error (fma), así fmod se
+// queda con la parte fraccionaria de las vueltas aunque m^2 sea grande.
+static double chirp_phase(double step, long m)
+{
+    double m2 = (double)((int64_t)m * m);
+    double half = 0.5 * step;
+    double cycles = half * m2;
+    double error = fma(half, m2, -cycles);
+    return -2.0 * M_PI * (fmod(cycles, 1.0) + error);
+}
+
+int czt_init(czt_plan_t *czt, int n_in, int m_out,
+             double f_start_hz, double f_step_hz, double fs_hz, float *workspace)
+{
+    if (n_in < 1 || m_out < 1 || fs_hz <= 0.0)
+        return -1;
+
+    int L = conv_size(n_in, m_out);
+    czt->n_in = n_in;
+    czt->m_out = m_out;
+    czt->L = L;
+
+    float *w = workspace;
+    if (fft_plan_init(&czt->plan, L, w) != 0)
+        return -1;
+    w += FFT_PLAN_TWIDDLE_SIZE(L);
+    czt->pre = w;       w += 2 * n_in;
+    czt->post = w;      w += 2 * m_out;
+    czt->kernel = w;    w += 2 * L;
+    czt->work = w;
+
+    double start = f_start_hz / fs_hz;  // ciclos por muestra
+    double step = f_step_hz / fs_hz;
+
+    // pre[n] = A^-n W^(n^2/2),  A = e^(i*2*pi*start)
+    for (int n = 0; n < n_in; n++) {
+        double phase = -2.0 * M_PI * fmod(start * n, 1.0) + chirp_phase(step, n);
+        czt->pre[2 * n]     = (float)cos(phase);
+        czt->pre[2 * n + 1] = (float)sin(phase);
+    }
+    // post[k] = W^(k^2/2)
+    for (int k = 0; k < m_out; k++) {
+        double phase = chirp_phase(step, k);
+        czt->post[2 * k]     = (float)cos(phase);
+        czt->post[2 * k + 1] = (float)sin(phase);
+    }
+
+    // Núcleo v[m] = W^(-m^2/2) para m = -(N-1) .. M-1, en orden circular
+    memset(czt->kernel, 0, 2 * L * sizeof(float));
+    for (int m = 0; m < m_out; m++) {
+        double phase = -chirp_phase(step, m);
+        czt->kernel[2 * m]     = (float)cos(phase);
+        czt->kernel[2 * m + 1] = (float)sin(phase);
+    }
+    for (int n = 1; n < n_in; n++) {
+        double phase = -chirp_phase(step, n);
+        czt->kernel[2 * (L - n)]     = (float)cos(phase);
+        czt->kernel[2 * (L - n) + 1] = (float)sin(phase);
+    }
+    fft_plan_forward(&czt->plan, czt->kernel);
+
+    // Se incluye el 1/L de la IFFT en el núcleo
+    float scale = 1.0f / L;
+    for (int i = 0; i < 2 * L; i++)
+        czt->kernel[i] *= scale;
+
+    return 0;
+}
+
+int czt_init_dft(czt_plan_t *czt, int n, float *workspace)
+{
+    return czt_init(czt, n, n, 0.0, 1.0, (double)n, workspace);
+}
+
+int czt_init_zoom(czt_plan_t *czt, int n_in, int m_out,
+                  double f_low_hz, double f_high_hz, double fs_hz, float *workspace)
+{
+    double step = (m_out > 1) ? (f_high_hz - f_low_hz) / (m_out - 1) : 0.0;
+    return czt_init(czt, n_in, m_out, f_low_hz, step, fs_hz, workspace);
+}
+
+czt_plan_t *czt_create(dsp_arena_t *arena, int n_in, int m_out,
+                       double f_start_hz, double f_step_hz, double fs_hz)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    czt_plan_t *czt = dsp_arena_alloc(arena, sizeof(*czt), 0, "czt");
+    float *workspace = (n_in > 0 && m_out > 0)
+        ? dsp_arena_alloc_floats(arena, czt_workspace_size(n_in, m_out), "czt") : NULL;
+    if (!czt || !workspace ||
+        czt_init(czt, n_in, m_out, f_start_hz, f_step_hz, fs_hz, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return czt;
+}
+
+czt_plan_t *czt_create_zoom(dsp_arena_t *arena, int n_in, int m_out,
+                            double f_low_hz, double f_high_hz, double fs_hz)
+{
+    double step = (m_out > 1) ? (f_high_hz - f_low_hz) / (m_out - 1) : 0.0;
+    return czt_create(arena, n_in, m_out, f_low_hz, step, fs_hz);
+}
+
+static void convolve_and_post(czt_plan_t *czt, float *out)
+{
+    int L = czt->L;
+    float *y = czt->work;
+
+    fft_plan_forward(&czt->plan, y);
+
+    // Y *= V, luego IFFT como conj(FFT(conj(.))) (el 1/L ya está en V)
+    for (int i = 0; i < L; i++) {
+        float yr = y[2 * i], yi = y[2 * i + 1];
+        float vr = czt->kernel[2 * i], vi = czt->kernel[2 * i + 1];
+        y[2 * i]     = yr * vr - yi * vi;
+        y[2 * i + 1] = -(yr * vi + yi * vr);
+    }
+    fft_plan_forward(&czt->plan, y);
+
+    // X[k] = W^(k^2/2) * g[k]
+    for (int k = 0; k < czt->m_out; k++) {
+        float gr = y[2 * k], gi = -y[2 * k + 1];
+        float pr = czt->post[2 * k], pi = czt->post[2 * k + 1];
+        out[2 * k]     = gr * pr - gi * pi;
+        out[2 * k + 1] = gr * pi + gi * pr;
+    }
+}
+
+void czt_compute(czt_plan_t *czt, const float *x, float *out)
+{
+    float *y = czt->work;
+
+    for (int n = 0; n < czt->n_in; n++) {
+        float xr = x[2 * n], xi = x[2 * n + 1];
+        float pr = czt->pre[2 * n], pi = czt->pre[2 * n + 1];
+        y[2 * n]     = xr * pr - xi * pi;
+        y[2 * n + 1] = xr * pi + xi * pr;
+    }
+    memset(y + 2 * czt->n_in, 0, 2 * (czt->L - czt->n_in) * sizeof(float));
+
+    convolve_and_post(czt, out);
+}
+
+void czt_compute_real(czt_plan_t *czt, const float *x, float *out)
+{
+    float *y = czt->work;
+
+    for (int n = 0; n < czt->n_in; n++) {
+        y[2 * n]     = x[n] * czt->pre[2 * n];
+        y[2 * n + 1] = x[n] * czt->pre[2 * n + 1];
+    }
+    memset(y + 2 * czt->n_in, 0, 2 * (czt->L - czt->n_in) * sizeof(float));
+
+    convolve_and_post(czt, out);
+}
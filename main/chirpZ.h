@@ -0,0 +1,49 @@
+#ifndef CHIRP_Z_H
+#define CHIRP_Z_H
+
+#include <stddef.h>
+#include "fftPlan.h"
+#include "dspArena.h"
+
+// -------------------- CHIRP-Z (BLUESTEIN) --------------------
+// Evalúa M puntos del espectro de N muestras en f_k = f_start + k*f_step,
+// para cualquier N y M (no hace falta potencia de 2), usando una convolución
+// circular de L = potencia de 2 >= N+M-1 puntos con el plan FFT del proyecto.
+//
+// Los chirps y el espectro del núcleo se calculan una sola vez en czt_init;
+// por bloque cuesta 2 FFT de L puntos + 3 productos complejos por punto.
+//   - DFT de largo arbitrario: czt_init_dft(plan, N, ...)
+//   - Zoom: czt_init_zoom(plan, N, M, 2000, 3000, 50000, ...) -> M bins entre 2 y 3 kHz
+
+typedef struct {
+    int n_in;
+    int m_out;
+    int L;
+    fft_plan_t plan;
+    float *pre;         // A^-n W^(n^2/2), N complejos
+    float *post;        // W^(k^2/2), M complejos
+    float *kernel;      // FFT de W^(-m^2/2), L complejos
+    float *work;        // L complejos
+} czt_plan_t;
+
+// floats de workspace que necesita un plan de n_in -> m_out
+size_t czt_workspace_size(int n_in, int m_out);
+
+// Devuelve 0 si OK, -1 si los parámetros no sirven
+int czt_init(czt_plan_t *czt, int n_in, int m_out,
+             double f_start_hz, double f_step_hz, double fs_hz, float *workspace);
+int czt_init_dft(czt_plan_t *czt, int n, float *workspace);
+int czt_init_zoom(czt_plan_t *czt, int n_in, int m_out,
+                  double f_low_hz, double f_high_hz, double fs_hz, float *workspace);
+
+// Plan + workspace desde la arena. NULL si no alcanza.
+czt_plan_t *czt_create(dsp_arena_t *arena, int n_in, int m_out,
+                       double f_start_hz, double f_step_hz, double fs_hz);
+czt_plan_t *czt_create_zoom(dsp_arena_t *arena, int n_in, int m_out,
+                            double f_low_hz, double f_high_hz, double fs_hz);
+
+// x: N complejos intercalados / N reales. out: M complejos intercalados.
+void czt_compute(czt_plan_t *czt, const float *x, float *out);
+void czt_compute_real(czt_plan_t *czt, const float *x, float *out);
+
+#endif
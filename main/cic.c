@@ -0,0 +1,131 @@
+#include <string.h>
+#include <math.h>
+#include "cic.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define CIC_DESIGN_GRID     256     // puntos de frecuencia para el diseño
+
+static int ceil_log2(int x)
+{
+    int bits = 0;
+    while ((1 << bits) < x)
+        bits++;
+    return bits;
+}
+
+size_t cic_workspace_size(int comp_taps)
+{
+    // coeficientes + línea de retardo duplicada
+    return (comp_taps > 0) ? 3 * (size_t)comp_taps : 0;
+}
+
+// |H(f)| del CIC normalizado a 1 en DC; f en ciclos por muestra de salida
+static double cic_response(double f, int order, int ratio)
+{
+    if (f == 0.0)
+        return 1.0;
+    double h = sin(M_PI * f) / (ratio * sin(M_PI * f / ratio));
+    return pow(fabs(h), order);
+}
+
+void cic_design_compensator(float *coeffs, int taps, int order, int ratio, float passband)
+{
+    double center = 0.5 * (taps - 1);
+    double fp = 0.5 * passband;
+    // La ventana de Hamming deja una transición de ~3.3/taps centrada en el
+    // corte: se corre media transición para que fp quede dentro de la banda
+    // plana (la inversa del CIC se sigue hasta el corte).
+    double fc = fmin(fp + 1.65 / taps, 0.5);
+    double dc = 0.0;
+
+    for (int n = 0; n < taps; n++) {
+        // Respuesta deseada real y par: h[n] = 2 * integral D(f) cos(2 pi f (n - c)) df
+        double acc = 0.0;
+        for (int k = 0; k < CIC_DESIGN_GRID; k++) {
+            double f = (k + 0.5) * 0.5 / CIC_DESIGN_GRID;
+            if (f > fc)
+                break;
+            acc += cos(2.0 * M_PI * f * (n - center)) / cic_response(f, order, ratio);
+        }
+        acc *= 2.0 * 0.5 / CIC_DESIGN_GRID;
+
+        double w = (taps > 1) ? 0.54 - 0.46 * cos(2.0 * M_PI * n / (taps - 1)) : 1.0;
+        coeffs[n] = (float)(acc * w);
+        dc += acc * w;
+    }
+    for (int n = 0; n < taps; n++)
+        coeffs[n] = (float)(coeffs[n] / dc);
+}
+
+int cic_init(cic_decimator_t *cic, int order, int ratio, int input_bits,
+             int comp_taps, float passband, float *workspace)
+{
+    if (order < 1 || order > CIC_MAX_ORDER || ratio < 1 || comp_taps < 0)
+        return -1;
+    int output_bits = input_bits + order * ceil_log2(ratio);
+    if (output_bits > 31)
+        return -1;
+
+    memset(cic, 0, sizeof(*cic));
+    cic->order = order;
+    cic->ratio = ratio;
+    cic->output_bits = output_bits;
+    cic->scale = (float)(1.0 / pow(ratio, order));
+
+    if (comp_taps > 0) {
+        float *coeffs = workspace;
+        cic_design_compensator(coeffs, comp_taps, order, ratio, passband);
+        fir_direct_init(&cic->comp, coeffs, comp_taps, workspace + comp_taps);
+        cic->use_comp = 1;
+    }
+    return 0;
+}
+
+cic_decimator_t *cic_create(dsp_arena_t *arena, int order, int ratio, int input_bits,
+                            int comp_taps, float passband)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    cic_decimator_t *cic = dsp_arena_alloc(arena, sizeof(*cic), 0, "cic");
+    float *workspace = NULL;
+    if (comp_taps > 0)
+        workspace = dsp_arena_alloc_floats(arena, cic_workspace_size(comp_taps), "cic");
+    if (!cic || (comp_taps > 0 && !workspace) ||
+        cic_init(cic, order, ratio, input_bits, comp_taps, passband, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return cic;
+}
+
+void cic_reset(cic_decimator_t *cic)
+{
+    cic->phase = 0;
+    memset(cic->integ, 0, sizeof(cic->integ));
+    memset(cic->comb, 0, sizeof(cic->comb));
+    if (cic->use_comp)
+        fir_direct_reset(&cic->comp);
+}
+
+int cic_push(cic_decimator_t *cic, int32_t x, float *out)
+{
+    int32_t raw;
+    if (!cic_push_raw(cic, x, &raw))
+        return 0;
+
+    float y = (float)raw * cic->scale;
+    *out = cic->use_comp ? fir_direct_sample(&cic->comp, y) : y;
+    return 1;
+}
+
+int cic_process(cic_decimator_t *cic, const uint16_t *in, int n, int stride, float *out)
+{
+    int count = 0;
+    for (int i = 0; i < n; i += stride) {
+        if (cic_push(cic, in[i], &out[count]))
+            count++;
+    }
+    return count;
+}
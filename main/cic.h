@@ -0,0 +1,83 @@
+#ifndef CIC_H
+#define CIC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "firFast.h"
+#include "dspArena.h"
+
+// -------------------- DECIMADOR CIC --------------------
+// Cascaded integrator-comb de orden N y decimación R (retardo diferencial 1):
+// N integradores a la tasa de entrada, N peines a la tasa de salida, sin
+// multiplicaciones. Ganancia R^N, o sea N*log2(R) bits más que la entrada.
+//
+// Se trabaja en enteros de 32 bits con desborde módulo 2^32: los
+// integradores desbordan pero la salida de los peines es exacta mientras
+// input_bits + N*ceil(log2(R)) <= 31 (lo verifica cic_init).
+//
+// La respuesta (sin(pi f R) / (R sin(pi f)))^N cae en la banda de paso; la
+// FIR de compensación (fir_direct a la tasa de salida) la aplana. La salida
+// queda en las mismas unidades que la entrada (códigos del ADC) pero con
+// parte fraccionaria: los bits extra que da el sobremuestreo.
+
+#define CIC_MAX_ORDER       6
+
+typedef struct {
+    int order;              // N
+    int ratio;              // R
+    int phase;              // muestras de entrada desde la última salida
+    int output_bits;        // input_bits + N*ceil(log2(R))
+    float scale;            // 1 / R^N
+    uint32_t integ[CIC_MAX_ORDER];
+    uint32_t comb[CIC_MAX_ORDER];   // entrada anterior de cada peine
+    int use_comp;
+    fir_direct_t comp;
+} cic_decimator_t;
+
+// floats de workspace para la FIR de compensación (0 si comp_taps = 0)
+size_t cic_workspace_size(int comp_taps);
+
+// Diseña por muestreo en frecuencia (ventana de Hamming) una FIR simétrica de
+// taps coeficientes que invierte la caída del CIC hasta passband (fracción de
+// la Nyquist de salida, p.ej. 0.5) y corta media transición (1.65/taps ciclos
+// por muestra) más arriba, así el borde queda plano: con 15 taps, N = 4 y
+// R = 8, +-0.25 dB hasta passband (fila cic_comp de dspBench). Ganancia 1 en DC.
+void cic_design_compensator(float *coeffs, int taps, int order, int ratio, float passband);
+
+// comp_taps = 0: sin compensación. workspace: cic_workspace_size(comp_taps) floats.
+// Devuelve 0 si OK, -1 si los parámetros no sirven o no entran en 32 bits.
+int cic_init(cic_decimator_t *cic, int order, int ratio, int input_bits,
+             int comp_taps, float passband, float *workspace);
+// Objeto + compensación desde la arena. NULL si no alcanza o los parámetros no sirven.
+cic_decimator_t *cic_create(dsp_arena_t *arena, int order, int ratio, int input_bits,
+                            int comp_taps, float passband);
+void cic_reset(cic_decimator_t *cic);
+
+// Entero de salida del CIC (ganancia R^N, sin compensar)
+static inline int cic_push_raw(cic_decimator_t *cic, int32_t x, int32_t *out)
+{
+    uint32_t acc = (uint32_t)x;
+    for (int i = 0; i < cic->order; i++) {
+        cic->integ[i] += acc;
+        acc = cic->integ[i];
+    }
+    if (++cic->phase < cic->ratio)
+        return 0;
+    cic->phase = 0;
+
+    for (int i = 0; i < cic->order; i++) {
+        uint32_t prev = cic->comb[i];
+        cic->comb[i] = acc;
+        acc -= prev;
+    }
+    *out = (int32_t)acc;
+    return 1;
+}
+
+// Devuelve 1 y escribe *out (unidades de entrada, compensada) cada R entradas
+int cic_push(cic_decimator_t *cic, int32_t x, float *out);
+// Procesa n muestras de entrada (con paso stride, para datos intercalados por
+// canal). Devuelve la cantidad de salidas escritas en out.
+int cic_process(cic_decimator_t *cic, const uint16_t *in, int n, int stride, float *out);
+
+#endif
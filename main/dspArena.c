@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <string.h>
+#include "dspArena.h"
+
+void dsp_arena_init(dsp_arena_t *arena, void *buffer, size_t size)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->base = (uint8_t *)buffer;
+    arena->size = size;
+}
+
+static void record(dsp_arena_t *arena, const char *name, size_t bytes)
+{
+    // Asignaciones seguidas del mismo objeto (struct + buffers) se suman; un
+    // mark en el medio es otro *_create, aunque el nombre sea el mismo
+    if (arena->num_entries > 0) {
+        dsp_arena_entry_t *last = &arena->entries[arena->num_entries - 1];
+        if (last->object == arena->object &&
+            (last->name == name || (last->name && name && strcmp(last->name, name) == 0))) {
+            last->bytes += bytes;
+            return;
+        }
+    }
+    if (arena->num_entries < DSP_ARENA_MAX_ENTRIES) {
+        arena->entries[arena->num_entries].name = name;
+        arena->entries[arena->num_entries].bytes = bytes;
+        arena->entries[arena->num_entries].object = arena->object;
+        arena->num_entries++;
+    } else {
+        // Tabla llena: se acumula en la última entrada
+        arena->entries[DSP_ARENA_MAX_ENTRIES - 1].name = "(otros)";
+        arena->entries[DSP_ARENA_MAX_ENTRIES - 1].bytes += bytes;
+    }
+}
+
+void *dsp_arena_alloc(dsp_arena_t *arena, size_t bytes, size_t align, const char *name)
+{
+    if (align == 0)
+        align = DSP_ARENA_ALIGN;
+
+    uintptr_t addr = (uintptr_t)(arena->base + arena->used);
+    size_t pad = (size_t)((align - (addr & (align - 1))) & (align - 1));
+
+    if (pad + bytes > arena->size - arena->used) {
+        arena->failed += bytes;
+        return NULL;
+    }
+
+    void *ptr = arena->base + arena->used + pad;
+    arena->used += pad + bytes;
+    if (arena->used > arena->peak)
+        arena->peak = arena->used;
+    record(arena, name, pad + bytes);
+    return ptr;
+}
+
+float *dsp_arena_alloc_floats(dsp_arena_t *arena, size_t count, const char *name)
+{
+    return (float *)dsp_arena_alloc(arena, count * sizeof(float), DSP_ARENA_ALIGN, name);
+}
+
+dsp_arena_mark_t dsp_arena_mark(dsp_arena_t *arena)
+{
+    arena->object++;
+    dsp_arena_mark_t mark = {
+        .used = arena->used,
+        .num_entries = arena->num_entries,
+        .last_bytes = arena->num_entries ? arena->entries[arena->num_entries - 1].bytes : 0,
+    };
+    return mark;
+}
+
+void dsp_arena_rollback(dsp_arena_t *arena, dsp_arena_mark_t mark)
+{
+    arena->used = mark.used;
+    arena->num_entries = mark.num_entries;
+    if (mark.num_entries > 0)
+        arena->entries[mark.num_entries - 1].bytes = mark.last_bytes;
+}
+
+void dsp_arena_reset(dsp_arena_t *arena)
+{
+    arena->used = 0;
+    arena->num_entries = 0;
+    arena->failed = 0;
+}
+
+size_t dsp_arena_remaining(const dsp_arena_t *arena)
+{
+    return arena->size - arena->used;
+}
+
+void dsp_arena_report(const dsp_arena_t *arena, const char *title)
+{
+    printf("---- %s: memoria DSP ----\n", title);
+    for (int i = 0; i < arena->num_entries; i++) {
+        printf("%-24s %8u bytes\n", arena->entries[i].name ? arena->entries[i].name : "?",
+               (unsigned)arena->entries[i].bytes);
+    }
+    printf("%-24s %8u / %u bytes (pico %u, libres %u)\n", "total",
+           (unsigned)arena->used, (unsigned)arena->size,
+           (unsigned)arena->peak, (unsigned)(arena->size - arena->used));
+    if (arena->failed)
+        printf("%-24s %8u bytes NO ENTRARON\n", "", (unsigned)arena->failed);
+}
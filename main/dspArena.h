@@ -0,0 +1,62 @@
+#ifndef DSP_ARENA_H
+#define DSP_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -------------------- ARENA DSP --------------------
+// Asignador lineal sobre un buffer que provee el llamador (array estático en
+// DRAM, IRAM o PSRAM). Todos los filtros, planes y objetos de la cadena se
+// crean desde una arena al arrancar: no hay malloc en régimen permanente ni
+// arrays grandes en el stack de la tarea.
+//
+// Cada asignación lleva un nombre; dsp_arena_report() lista los bytes por
+// objeto para dimensionar la memoria (y la cantidad de canales) de antemano.
+// Los *_create toman un mark al empezar: las asignaciones seguidas con el
+// mismo nombre y sin otro mark en el medio (struct + buffers) forman una
+// sola entrada, y dos instancias del mismo objeto salen en entradas separadas.
+
+#define DSP_ARENA_ALIGN         16      // esp-dsp pide buffers alineados a 16
+#define DSP_ARENA_MAX_ENTRIES   32
+
+typedef struct {
+    const char *name;
+    size_t bytes;           // incluye el relleno de alineación
+    uint32_t object;        // mark en el que se abrió la entrada
+} dsp_arena_entry_t;
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t peak;
+    size_t failed;          // bytes pedidos que no entraron
+    uint32_t object;        // se incrementa en cada dsp_arena_mark
+    int num_entries;
+    dsp_arena_entry_t entries[DSP_ARENA_MAX_ENTRIES];
+} dsp_arena_t;
+
+typedef struct {
+    size_t used;
+    int num_entries;
+    size_t last_bytes;      // con la tabla llena todo se suma a la última entrada
+} dsp_arena_mark_t;
+
+void dsp_arena_init(dsp_arena_t *arena, void *buffer, size_t size);
+
+// Devuelve NULL si no alcanza. align debe ser potencia de 2 (0 = DSP_ARENA_ALIGN).
+void *dsp_arena_alloc(dsp_arena_t *arena, size_t bytes, size_t align, const char *name);
+float *dsp_arena_alloc_floats(dsp_arena_t *arena, size_t count, const char *name);
+
+// Punto de retroceso: lo asignado después de mark se libera con rollback.
+// También abre un objeto nuevo en el reporte.
+dsp_arena_mark_t dsp_arena_mark(dsp_arena_t *arena);
+void dsp_arena_rollback(dsp_arena_t *arena, dsp_arena_mark_t mark);
+void dsp_arena_reset(dsp_arena_t *arena);
+
+size_t dsp_arena_remaining(const dsp_arena_t *arena);
+
+// Tabla de bytes por objeto, usados, pico y libres (por printf)
+void dsp_arena_report(const dsp_arena_t *arena, const char *title);
+
+#endif
@@ -0,0 +1,1369 @@
+// Verificación de precisión y rendimiento de todos los kernels DSP.
+// Cada kernel corre sobre señales patrón (tono, chirp, impulso, ruido) y se
+// compara contra una referencia en double (DFT directa, convolución o
+// recursión). Falla si el error o los ns/muestra pasan los límites de la
+// tabla `limits`.
+//
+// En la placa: seleccionar dspBench.c en main/CMakeLists.txt. Ahí se verifica
+// sólo la precisión; los ns/muestra se imprimen pero no tienen límite (no hay
+// mediciones de referencia en el ESP32 contra las cuales fallar). La
+// excepción es sos_speedup, que compara dos tiempos medidos en la placa.
+// En el host:
+//   gcc -O2 -Imain main/dspBench.c main/dspArena.c main/filterKernels.c main/fftPlan.c main/fftSplit.c main/firFast.c main/chirpZ.c main/cic.c main/lms.c main/spectralFeatures.c main/gccPhat.c main/slidingDft.c main/octaveBank.c main/sosMulti.c main/medianFilter.c main/adcCapture.c -lm -o dspBench
+//   ./dspBench     (código de salida 1 si algo empeoró)
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#else
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "dspArena.h"
+#include "filterKernels.h"
+#include "fftPlan.h"
+#include "fftSplit.h"
+#include "firFast.h"
+#include "chirpZ.h"
+#include "cic.h"
+#include "lms.h"
+#include "spectralFeatures.h"
+#include "gccPhat.h"
+#include "slidingDft.h"
+#include "octaveBank.h"
+#include "sosMulti.h"
+#include "medianFilter.h"
+#include "adcCapture.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define N_SIGNAL    1024
+#define N_SCRATCH   (4 * N_SIGNAL)      // buffer de trabajo compartido por los casos
+#define N_FFT       256
+#define N_CZT       100
+#define REPEATS     8
+#define NUM_SIGNALS 4
+
+// Zoom de fftCZT.c: M bins entre 2 y 3 kHz de ch6 (25 kHz), N y M que no
+// son potencia de 2. En el host además un bloque largo (índices de chirp
+// cerca de 2^16) con el workspace en el heap.
+#define CZT_ZOOM_N      200
+#define CZT_ZOOM_M      57
+#define CZT_ZOOM_FS     25000.0
+#define CZT_ZOOM_LOW    2000.0
+#define CZT_ZOOM_HIGH   3000.0
+#define CZT_LONG_N      50000
+#define CZT_LONG_M      64
+
+// Picos de spectralFeatures: tonos fuera de bin (en bins de N_FFT) a la tasa
+// de ch6, con ventana de Hann, de mayor a menor amplitud
+#define PEAK_TONES      3
+#define PEAK_FS         25000.0
+static const double peak_bins[PEAK_TONES] = {20.3, 47.7, 90.5};
+static const double peak_amps[PEAK_TONES] = {0.5, 0.3, 0.15};
+
+// Coeficientes de filterFIR.c / filterFIRQ15.c / filterIIR.c
+#define FIR_ORDER 6
+static const float fir_coeffs[FIR_ORDER] = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
+static const int16_t fir_coeffs_q15[FIR_ORDER] = {
+    (int16_t)(-0.0882352941f * 32768),
+    (int16_t)(0.1470588235f * 32768),
+    (int16_t)(0.4411764705f * 32768),
+    (int16_t)(0.4411764705f * 32768),
+    (int16_t)(0.1470588235f * 32768),
+    (int16_t)(-0.0882352941f * 32768)
+};
+#define IIR_ORDER 6
+static const float iir_coeffs_x[IIR_ORDER] = {0.0528f, 0.2640f, 0.5279f, 0.5279f, 0.2640f, 0.0528f};
+static const float iir_coeffs_y[IIR_ORDER] = {1.0f, 0.0f, 0.6335f, 0.0f, 0.0557f, 0.0f};
+#define NUM_SOS 3
+static const float iir_sos_coeffs_x[NUM_SOS * 3] = {1.0f, 2.0f, 1.0f,  1.0f, 2.0f, 1.0f,  1.0f, 1.0f, 0.0f};
+static const float iir_sos_coeffs_y[NUM_SOS * 3] = {1.0f, 0.0f, 0.5279f,  1.0f, 0.0f, 0.1056f,  1.0f, 0.0f, 0.0f};
+static const float iir_sos_gain[NUM_SOS] = {0.3820f, 0.2764f, 0.5000f};
+#define LONG_TAPS 255
+#define LONG_BLOCK 64
+
+// Decimador de adcCIC.c
+#define CIC_ORDER 4
+#define CIC_RATIO 8
+#define CIC_OFFSET 2048
+#define CIC_COMP_TAPS 15
+#define CIC_PASSBAND 0.5f
+// Tonos de k ciclos en CIC_WINDOW salidas, medidos tras el transitorio
+#define CIC_WINDOW 64
+#define CIC_TONE_AMP 1500.0
+
+// Identificación de la FIR de filterFIR.c con ruido como referencia
+#define LMS_TAPS 16
+#define LMS_PASSES 8
+
+// Retardo entre dos copias del ruido: enteros de +-GCC_DELAY y fraccionarios
+// con un sinc de 2*GCC_SINC_HALF+1 coeficientes (ventana de Hann)
+#define GCC_BLOCK 256
+#define GCC_MAX_LAG 32
+#define GCC_DELAY 7
+#define GCC_SINC_HALF 16
+
+// DFT deslizante de fftImpl.c
+#define SDFT_N 64
+
+// Tercios de octava en fs = 1 (centros 0.2 * 2^(-k/3)), tonos en el centro de algunas bandas
+#define OCTAVE_OCTAVES 5
+#define OCTAVE_WINDOW N_SCRATCH
+#define OCTAVE_WINDOWS 3            // la primera ventana es el transitorio
+
+// La cascada de filterIIR.c en SOS_CHANNELS canales intercalados (las señales
+// patrón repetidas con distinta escala), SOS_SAMPLES muestras por canal
+#define SOS_CHANNELS 8
+#define SOS_SAMPLES (N_SCRATCH / SOS_CHANNELS)
+
+// Captura de ADC: CAPTURE_SAMPLES muestras de 2 canales en bloques de
+// CAPTURE_BLOCK (el último queda incompleto y con cantidad impar)
+#define CAPTURE_BLOCK 64
+#define CAPTURE_SAMPLES 501
+
+// Medianas: ventana chica (red de ordenamiento) y grande (montículos); las
+// ventanas pares y los percentiles pasan por las dos implementaciones
+#define MEDIAN_SMALL 7
+#define MEDIAN_LARGE 31
+#define MEDIAN_MAX_REF 32
+
+// Pico medido en el host: ~8 KB (fir_fast por FFT y octave_bank)
+#define DSP_ARENA_SIZE (10 * 1024)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+static dsp_arena_t arena;
+
+static float signals[NUM_SIGNALS][N_SIGNAL];
+static const char *signal_names[NUM_SIGNALS] = {"tono", "chirp", "impulso", "ruido"};
+static double ref[2 * N_SIGNAL];
+static float long_coeffs[LONG_TAPS];
+
+// Salida de cada caso y buffer de trabajo (entrada cuantizada, códigos, señal
+// larga, canales intercalados, ...). Un solo buffer para que entre en la DRAM
+// del ESP32; cada caso lo usa sólo mientras corre.
+static float out[2 * N_SIGNAL];
+static float scratch[N_SCRATCH] __attribute__((aligned(16)));
+
+static double now_ns(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time() * 1000.0;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+// -------------------- SEÑALES PATRÓN --------------------
+static void generate_signals(void)
+{
+    uint32_t seed = 12345;
+    for (int n = 0; n < N_SIGNAL; n++) {
+        signals[0][n] = 0.5f * (float)sin(2.0 * M_PI * 0.0473 * n);
+        signals[1][n] = 0.5f * (float)sin(M_PI * 0.5 * (double)n * n / N_SIGNAL);
+        signals[2][n] = (n == 3) ? 1.0f : 0.0f;
+        seed = seed * 1664525u + 1013904223u;
+        signals[3][n] = (float)((seed >> 8) / 16777216.0 - 0.5);
+    }
+    for (int i = 0; i < LONG_TAPS; i++) {
+        double t = i - (LONG_TAPS - 1) / 2.0;
+        double sinc = (t == 0.0) ? 0.1 : sin(2.0 * M_PI * 0.05 * t) / (M_PI * t);
+        long_coeffs[i] = (float)(sinc * (0.54 - 0.46 * cos(2.0 * M_PI * i / (LONG_TAPS - 1))));
+    }
+}
+
+// -------------------- REFERENCIAS EN DOUBLE --------------------
+static void ref_dft(const float *x, int n, int stride_real)
+{
+    // stride_real: 1 = x son n complejos intercalados, 0 = x son n reales
+    for (int k = 0; k < n; k++) {
+        double re = 0.0, im = 0.0;
+        for (int t = 0; t < n; t++) {
+            double a = -2.0 * M_PI * (double)((long)k * t % n) / n;
+            double xr = stride_real ? x[2 * t] : x[t];
+            double xi = stride_real ? x[2 * t + 1] : 0.0;
+            re += xr * cos(a) - xi * sin(a);
+            im += xr * sin(a) + xi * cos(a);
+        }
+        ref[2 * k] = re;
+        ref[2 * k + 1] = im;
+    }
+}
+
+static void ref_fir(const float *x, const float *h, int taps)
+{
+    for (int n = 0; n < N_SIGNAL; n++) {
+        double acc = 0.0;
+        for (int i = 0; i < taps && i <= n; i++)
+            acc += (double)h[i] * x[n - i];
+        ref[n] = acc;
+    }
+}
+
+static void ref_iir(const float *x)
+{
+    double xb[IIR_ORDER] = {0}, yb[IIR_ORDER] = {0};
+    for (int n = 0; n < N_SIGNAL; n++) {
+        for (int i = IIR_ORDER - 1; i > 0; i--) {
+            xb[i] = xb[i - 1];
+            yb[i] = yb[i - 1];
+        }
+        xb[0] = x[n];
+        double y = 0.0;
+        for (int i = 0; i < IIR_ORDER; i++)
+            y += iir_coeffs_x[i] * xb[i];
+        for (int i = 1; i < IIR_ORDER; i++)
+            y -= iir_coeffs_y[i] * yb[i];
+        yb[0] = y;
+        ref[n] = y;
+    }
+}
+
+// N promedios móviles de R muestras en cascada, tomando una de cada R.
+// Las etapas van en la mitad alta de ref; la salida (N_SIGNAL / R) en la baja.
+static int ref_cic(const uint16_t *codes)
+{
+    double *stage = ref + N_SIGNAL;
+    for (int n = 0; n < N_SIGNAL; n++)
+        stage[n] = codes[n];
+    for (int s = 0; s < CIC_ORDER; s++) {
+        for (int n = N_SIGNAL - 1; n >= 0; n--) {
+            double acc = 0.0;
+            for (int k = 0; k < CIC_RATIO && k <= n; k++)
+                acc += stage[n - k];
+            stage[n] = acc / CIC_RATIO;
+        }
+    }
+    int count = 0;
+    for (int n = CIC_RATIO - 1; n < N_SIGNAL; n += CIC_RATIO)
+        ref[count++] = stage[n] - CIC_OFFSET;
+    return count;
+}
+
+static void ref_sos(const float *x)
+{
+    double xs[NUM_SOS][2] = {{0}}, ys[NUM_SOS][2] = {{0}};
+    for (int n = 0; n < N_SIGNAL; n++) {
+        double v = x[n];
+        for (int s = 0; s < NUM_SOS; s++) {
+            const float *b = &iir_sos_coeffs_x[3 * s];
+            const float *a = &iir_sos_coeffs_y[3 * s];
+            double y = (b[0] * v + b[1] * xs[s][0] + b[2] * xs[s][1]
+                        - a[1] * ys[s][0] - a[2] * ys[s][1]) / a[0];
+            xs[s][1] = xs[s][0];
+            xs[s][0] = v;
+            ys[s][1] = ys[s][0];
+            ys[s][0] = y;
+            v = y * iir_sos_gain[s];
+        }
+        ref[n] = v;
+    }
+}
+
+// Error RMS de out[offset ..] contra ref[0 ..], relativo al RMS de la referencia
+static double rel_error(const float *out, int offset, int n, double out_scale)
+{
+    double err = 0.0, power = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = out[i + offset] * out_scale - ref[i];
+        err += d * d;
+        power += ref[i] * ref[i];
+    }
+    return (power > 0.0) ? sqrt(err / power) : sqrt(err / n);
+}
+
+// -------------------- CASOS --------------------
+typedef struct {
+    double err;
+    double ns;
+} bench_result_t;
+
+// La arena no alcanzó para el kernel: error infinito, el caso falla
+static bench_result_t no_memory(dsp_arena_mark_t mark)
+{
+    bench_result_t r = {INFINITY, 0.0};
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+static bench_result_t bench_fft(int variant)
+{
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    fft_plan_t *plan = fft_plan_create(&arena, N_FFT);
+    if (!plan)
+        return no_memory(mark);
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        const float *x = signals[s];
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            memcpy(out, x, 2 * N_FFT * sizeof(float));
+            if (variant == 3) {
+                // fft() de fftSplit.c: partes separadas en scratch
+                for (int k = 0; k < N_FFT; k++) {
+                    scratch[k] = out[2 * k];
+                    scratch[N_FFT + k] = out[2 * k + 1];
+                }
+            }
+            double t0 = now_ns();
+            if (variant == 0)
+                fft_plan_forward_radix2(plan, out);
+            else if (variant == 1)
+                fft_plan_forward(plan, out);
+            else if (variant == 2)
+                fft_plan_forward_real(plan, out);
+            else
+                fft(scratch, scratch + N_FFT, N_FFT);
+            best = fmin(best, now_ns() - t0);
+            if (variant == 3) {
+                for (int k = 0; k < N_FFT; k++) {
+                    out[2 * k] = scratch[k];
+                    out[2 * k + 1] = scratch[N_FFT + k];
+                }
+            }
+        }
+        double ns = best / (2.0 * N_FFT);
+
+        if (variant != 2) {
+            ref_dft(x, N_FFT, 1);
+        } else {
+            // Espectro real de 2*N_FFT muestras, formato empaquetado
+            ref_dft(x, 2 * N_FFT, 0);
+            ref[1] = ref[2 * N_FFT];
+        }
+        double e = rel_error(out, 0, 2 * N_FFT, 1.0);
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+static bench_result_t bench_czt(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    czt_plan_t *czt = czt_create(&arena, N_CZT, N_CZT, 0.0, 1.0, N_CZT);
+    if (!czt)
+        return no_memory(mark);
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            double t0 = now_ns();
+            czt_compute_real(czt, signals[s], out);
+            best = fmin(best, now_ns() - t0);
+        }
+        double ns = best / N_CZT;
+
+        ref_dft(signals[s], N_CZT, 0);
+        double e = rel_error(out, 0, 2 * N_CZT, 1.0);
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+// DFT en double de x (n reales) en f_k = low + k * (high - low) / (m - 1), k < m
+static void ref_zoom(const float *x, int n, int m, double low, double high, double fs)
+{
+    for (int k = 0; k < m; k++) {
+        double f = (low + k * (high - low) / (m - 1)) / fs;
+        double re = 0.0, im = 0.0;
+        for (int t = 0; t < n; t++) {
+            double a = -2.0 * M_PI * fmod(f * t, 1.0);
+            re += x[t] * cos(a);
+            im += x[t] * sin(a);
+        }
+        ref[2 * k] = re;
+        ref[2 * k + 1] = im;
+    }
+}
+
+// czt_create_zoom con paso fraccionario y M != N contra la DFT directa en
+// las mismas frecuencias
+static bench_result_t bench_czt_zoom(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    czt_plan_t *czt = czt_create_zoom(&arena, CZT_ZOOM_N, CZT_ZOOM_M, CZT_ZOOM_LOW, CZT_ZOOM_HIGH,
+                                      CZT_ZOOM_FS);
+    if (!czt)
+        return no_memory(mark);
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            double t0 = now_ns();
+            czt_compute_real(czt, signals[s], out);
+            best = fmin(best, now_ns() - t0);
+        }
+        double ns = best / CZT_ZOOM_N;
+
+        ref_zoom(signals[s], CZT_ZOOM_N, CZT_ZOOM_M, CZT_ZOOM_LOW, CZT_ZOOM_HIGH, CZT_ZOOM_FS);
+        double e = rel_error(out, 0, 2 * CZT_ZOOM_M, 1.0);
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+
+#ifndef ESP_PLATFORM
+    // Tono entre bins más ruido, CZT_LONG_N muestras: no entra en la DRAM
+    czt_plan_t plan;
+    float *x = malloc(CZT_LONG_N * sizeof(float));
+    float *workspace = malloc(czt_workspace_size(CZT_LONG_N, CZT_LONG_M) * sizeof(float));
+    if (!x || !workspace ||
+        czt_init_zoom(&plan, CZT_LONG_N, CZT_LONG_M, CZT_ZOOM_LOW, CZT_ZOOM_HIGH, CZT_ZOOM_FS,
+                      workspace) != 0) {
+        r.err = INFINITY;
+    } else {
+        uint32_t seed = 1;
+        for (int n = 0; n < CZT_LONG_N; n++) {
+            seed = seed * 1664525u + 1013904223u;
+            x[n] = (float)(0.5 * sin(2.0 * M_PI * 2437.3 / CZT_ZOOM_FS * n)
+                           + 0.01 * ((seed >> 8) / 16777216.0 - 0.5));
+        }
+        czt_compute_real(&plan, x, out);
+        ref_zoom(x, CZT_LONG_N, CZT_LONG_M, CZT_ZOOM_LOW, CZT_ZOOM_HIGH, CZT_ZOOM_FS);
+        r.err = fmax(r.err, rel_error(out, 0, 2 * CZT_LONG_M, 1.0));
+    }
+    free(x);
+    free(workspace);
+#endif
+    return r;
+}
+
+static bench_result_t bench_filter(int kernel)
+{
+    bench_result_t r = {0.0, 0.0};
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        const float *x = signals[s];
+        int offset = 0;
+        double scale = 1.0;
+        double best = 1e30;
+
+        for (int rep = 0; rep < REPEATS; rep++) {
+            dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+            double t0;
+            switch (kernel) {
+            case 0: {
+                fir_state_t *fir = fir_create(&arena, fir_coeffs, FIR_ORDER);
+                if (!fir)
+                    return no_memory(mark);
+                t0 = now_ns();
+                for (int n = 0; n < N_SIGNAL; n++)
+                    out[n] = fir_filter(fir, x[n]);
+                break;
+            }
+            case 1: {
+                fir_q15_state_t *fir = fir_q15_create(&arena, fir_coeffs_q15, FIR_ORDER);
+                if (!fir)
+                    return no_memory(mark);
+                int16_t *q = (int16_t *)scratch;
+                for (int n = 0; n < N_SIGNAL; n++)
+                    q[n] = (int16_t)lrintf(x[n] * 32767.0f);
+                t0 = now_ns();
+                for (int n = 0; n < N_SIGNAL; n++)
+                    out[n] = fir_filter_q15(fir, q[n]);
+                scale = 1.0 / 32767.0;
+                break;
+            }
+            case 2:
+            case 3: {
+                // crossover enorme fuerza la forma directa, 0 fuerza la FFT
+                fir_fast_t *fir = fir_fast_create(&arena, long_coeffs, LONG_TAPS, LONG_BLOCK,
+                                                  kernel == 2 ? LONG_TAPS + 1 : 0);
+                if (!fir)
+                    return no_memory(mark);
+                t0 = now_ns();
+                fir_fast_process(fir, x, out, N_SIGNAL);
+                offset = fir_fast_latency(fir);
+                break;
+            }
+            case 4: {
+                iir_state_t *iir = iir_create(&arena, iir_coeffs_x, iir_coeffs_y, IIR_ORDER);
+                if (!iir)
+                    return no_memory(mark);
+                t0 = now_ns();
+                for (int n = 0; n < N_SIGNAL; n++)
+                    out[n] = iir_filter(iir, x[n]);
+                break;
+            }
+            default: {
+                iir_sos_state_t *iir = iir_sos_create(&arena, iir_sos_coeffs_x, iir_sos_coeffs_y,
+                                                      iir_sos_gain, NUM_SOS);
+                if (!iir)
+                    return no_memory(mark);
+                t0 = now_ns();
+                for (int n = 0; n < N_SIGNAL; n++)
+                    out[n] = iir_sos_filter(iir, x[n]);
+                break;
+            }
+            }
+            best = fmin(best, now_ns() - t0);
+            dsp_arena_rollback(&arena, mark);
+        }
+
+        switch (kernel) {
+        case 0: ref_fir(x, fir_coeffs, FIR_ORDER); break;
+        case 1: {
+            // Referencia con los coeficientes ya cuantizados y la misma entrada Q15
+            float *xq = scratch;
+            float hq[FIR_ORDER];
+            for (int n = 0; n < N_SIGNAL; n++)
+                xq[n] = (float)lrintf(x[n] * 32767.0f) / 32767.0f;
+            for (int i = 0; i < FIR_ORDER; i++)
+                hq[i] = fir_coeffs_q15[i] / 32768.0f;
+            ref_fir(xq, hq, FIR_ORDER);
+            break;
+        }
+        case 2:
+        case 3: ref_fir(x, long_coeffs, LONG_TAPS); break;
+        case 4: ref_iir(x); break;
+        default: ref_sos(x); break;
+        }
+
+        double e = rel_error(out, offset, N_SIGNAL - offset, scale);
+        double ns = best / N_SIGNAL;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    return r;
+}
+
+static bench_result_t bench_cic(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    uint16_t *codes = (uint16_t *)scratch;
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        // Códigos de 12 bits centrados, como los entrega el ADC
+        for (int n = 0; n < N_SIGNAL; n++)
+            codes[n] = (uint16_t)(CIC_OFFSET + lrintf(signals[s][n] * 2047.0f));
+
+        double best = 1e30;
+        int count = 0;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+            cic_decimator_t *cic = cic_create(&arena, CIC_ORDER, CIC_RATIO, 12, 0, 0.0f);
+            if (!cic)
+                return no_memory(mark);
+            double t0 = now_ns();
+            count = cic_process(cic, codes, N_SIGNAL, 1, out);
+            best = fmin(best, now_ns() - t0);
+            dsp_arena_rollback(&arena, mark);
+        }
+        for (int j = 0; j < count; j++)
+            out[j] -= CIC_OFFSET;
+
+        int n_ref = ref_cic(codes);
+        double e = (count == n_ref) ? rel_error(out, 0, count, 1.0) : 1.0;
+        double ns = best / N_SIGNAL;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    return r;
+}
+
+// Con la FIR de compensación de adcCIC.c: error en dB de la ganancia del
+// CIC+FIR respecto de 1 para tonos de k/CIC_WINDOW ciclos por salida, desde
+// DC hasta el borde passband * fs_out / 2 (el peor). El tiempo es el del tono
+// en el borde.
+static bench_result_t bench_cic_comp(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    uint16_t *codes = (uint16_t *)scratch;
+    int k_edge = (int)(0.5f * CIC_PASSBAND * CIC_WINDOW);
+
+    for (int k = 0; k <= k_edge; k++) {
+        double f = (double)k / (CIC_WINDOW * CIC_RATIO);    // ciclos por muestra de entrada
+        for (int n = 0; n < N_SIGNAL; n++)
+            codes[n] = (uint16_t)(CIC_OFFSET + lrint(CIC_TONE_AMP * cos(2.0 * M_PI * f * n)));
+
+        double best = 1e30;
+        int count = 0;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+            cic_decimator_t *cic = cic_create(&arena, CIC_ORDER, CIC_RATIO, 12, CIC_COMP_TAPS, CIC_PASSBAND);
+            if (!cic)
+                return no_memory(mark);
+            double t0 = now_ns();
+            count = cic_process(cic, codes, N_SIGNAL, 1, out);
+            best = fmin(best, now_ns() - t0);
+            dsp_arena_rollback(&arena, mark);
+        }
+        if (count < 2 * CIC_WINDOW)
+            return (bench_result_t){INFINITY, 0.0};
+
+        // Amplitud por proyección sobre un número entero de ciclos
+        double re = 0.0, im = 0.0;
+        for (int j = count - CIC_WINDOW; j < count; j++) {
+            double phase = 2.0 * M_PI * k * j / CIC_WINDOW;
+            re += (out[j] - CIC_OFFSET) * cos(phase);
+            im += (out[j] - CIC_OFFSET) * sin(phase);
+        }
+        double gain = sqrt(re * re + im * im) / CIC_WINDOW / ((k == 0) ? CIC_TONE_AMP : 0.5 * CIC_TONE_AMP);
+        double e = fabs(20.0 * log10(gain));
+        if (e > r.err) r.err = e;
+        r.ns = best / N_SIGNAL;
+    }
+    return r;
+}
+
+// Error residual relativo (e^2 / d^2) en la última pasada, ya convergido.
+// El tiempo es el de la última pasada.
+static bench_result_t bench_lms(int block)
+{
+    bench_result_t r = {0.0, 0.0};
+    const float *x = signals[3];
+    float *d = scratch;
+
+    // Convolución circular: la señal se repite en cada pasada
+    for (int n = 0; n < N_SIGNAL; n++) {
+        double acc = 0.0;
+        for (int i = 0; i < FIR_ORDER; i++)
+            acc += (double)fir_coeffs[i] * x[(n - i + N_SIGNAL) % N_SIGNAL];
+        d[n] = (float)acc;
+    }
+
+    double best = 1e30;
+    for (int rep = 0; rep < REPEATS; rep++) {
+        dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+        nlms_t *nlms = block ? NULL : nlms_create(&arena, LMS_TAPS, 0.5f);
+        fblms_t *fblms = block ? fblms_create(&arena, LMS_TAPS, 0.5f) : NULL;
+        if (!nlms && !fblms)
+            return no_memory(mark);
+        double t0 = 0.0;
+        for (int pass = 0; pass < LMS_PASSES; pass++) {
+            t0 = now_ns();
+            if (block)
+                fblms_process(fblms, x, d, out, N_SIGNAL);
+            else
+                nlms_process(nlms, x, d, out, N_SIGNAL);
+        }
+        best = fmin(best, now_ns() - t0);
+        dsp_arena_rollback(&arena, mark);
+    }
+
+    double err = 0.0, power = 0.0;
+    for (int n = 0; n < N_SIGNAL; n++) {
+        err += (double)out[n] * out[n];
+        power += (double)d[n] * d[n];
+    }
+    r.err = sqrt(err / power);
+    r.ns = best / N_SIGNAL;
+    return r;
+}
+
+// variant 0: error máximo en dB de spectral_to_db contra 10*log10.
+// variant 1: potencia total, centroide y RMS contra la DFT en double.
+static bench_result_t bench_spectral(int variant)
+{
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    fft_plan_t *plan = fft_plan_create(&arena, N_FFT);
+    float *mag2 = scratch;
+    float *db = scratch + N_FFT;
+    if (!plan)
+        return no_memory(mark);
+    int bins = N_FFT / 2 + 1;
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        const float *x = signals[s];
+        for (int n = 0; n < N_FFT; n++) {
+            out[2 * n] = x[n];
+            out[2 * n + 1] = 0.0f;
+        }
+        fft_plan_forward(plan, out);
+        spectral_mag2(out, SPECTRAL_COMPLEX, N_FFT, mag2);
+
+        spectral_features_t f;
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            double t0 = now_ns();
+            if (variant == 0)
+                spectral_to_db(mag2, db, bins);
+            else
+                spectral_features(out, SPECTRAL_COMPLEX, N_FFT, 1.0f, SPECTRAL_MAX_PEAKS, mag2, &f);
+            best = fmin(best, now_ns() - t0);
+        }
+
+        double e = 0.0;
+        if (variant == 0) {
+            for (int k = 0; k < bins; k++) {
+                if (mag2[k] > 1e-30f)
+                    e = fmax(e, fabs(db[k] - 10.0 * log10(mag2[k])));
+            }
+        } else {
+            ref_dft(x, N_FFT, 0);
+            double sum = 0.0, weighted = 0.0, ms = 0.0;
+            for (int k = 0; k < bins; k++) {
+                double p = ref[2 * k] * ref[2 * k] + ref[2 * k + 1] * ref[2 * k + 1];
+                sum += p;
+                weighted += p * k;
+            }
+            for (int n = 0; n < N_FFT; n++)
+                ms += (double)x[n] * x[n];
+            double centroid = weighted / sum / N_FFT;
+            double rms = sqrt(ms / N_FFT);
+            e = fmax(fabs(f.total_power - sum) / sum,
+                     fmax(fabs(f.centroid_hz - centroid) / centroid, fabs(f.rms - rms) / rms));
+        }
+        double ns = best / bins;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+// Los PEAK_TONES picos de spectral_features tienen que salir en el orden de
+// las amplitudes (si no, error infinito). mode 0: error de frecuencia en bins
+// de la interpolación (a partir de freq_hz); mode 1: error del nivel en dB
+// contra |A * N / 4|^2, el pico de un tono de amplitud A con Hann.
+static bench_result_t bench_spectral_peaks(int mode)
+{
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    fft_plan_t *plan = fft_plan_create(&arena, N_FFT);
+    if (!plan)
+        return no_memory(mark);
+
+    for (int n = 0; n < N_FFT; n++) {
+        double x = 0.0;
+        for (int t = 0; t < PEAK_TONES; t++)
+            x += peak_amps[t] * cos(2.0 * M_PI * peak_bins[t] * n / N_FFT + t);
+        out[2 * n] = (float)(x * (0.5 - 0.5 * cos(2.0 * M_PI * n / N_FFT)));
+        out[2 * n + 1] = 0.0f;
+    }
+    fft_plan_forward(plan, out);
+
+    spectral_features_t f;
+    double best = 1e30;
+    for (int rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns();
+        spectral_features(out, SPECTRAL_COMPLEX, N_FFT, (float)PEAK_FS, PEAK_TONES, NULL, &f);
+        best = fmin(best, now_ns() - t0);
+    }
+    dsp_arena_rollback(&arena, mark);
+
+    if (f.num_peaks != PEAK_TONES)
+        return (bench_result_t){INFINITY, 0.0};
+    double bin_hz = PEAK_FS / N_FFT;
+    for (int t = 0; t < PEAK_TONES; t++) {
+        double bin_err = fabs(f.peaks[t].freq_hz / bin_hz - peak_bins[t]);
+        if (bin_err > 0.5)
+            return (bench_result_t){INFINITY, 0.0};     // otro tono u orden equivocado
+        double level = 20.0 * log10(peak_amps[t] * N_FFT / 4.0);
+        double e = (mode == 0) ? bin_err : fabs(f.peaks[t].power_db - level);
+        if (e > r.err) r.err = e;
+    }
+    r.ns = best / (N_FFT / 2 + 1);
+    return r;
+}
+
+// y[n] = x[n - delay] con delay fraccionario: interpolación con sinc
+// enventanado sobre el ruido, que tiene muestras de sobra a los dos lados
+static void fractional_delay(const float *x, float *y, int n, double delay)
+{
+    int whole = (int)floor(delay);
+    double frac = delay - whole;
+    for (int i = 0; i < n; i++) {
+        double acc = 0.0;
+        for (int k = -GCC_SINC_HALF; k <= GCC_SINC_HALF; k++) {
+            double t = k - frac;
+            double sinc = (fabs(t) < 1e-12) ? 1.0 : sin(M_PI * t) / (M_PI * t);
+            double window = 0.5 + 0.5 * cos(M_PI * t / (GCC_SINC_HALF + 1));
+            acc += x[i - whole - k] * sinc * window;
+        }
+        y[i] = (float)acc;
+    }
+}
+
+// Error absoluto del lag estimado. fractional = 0: retardos enteros de
+// +-GCC_DELAY (copias desplazadas del ruido). fractional = 1: retardos con
+// fracción, que pasan por la interpolación parabólica del pico.
+static bench_result_t bench_gcc_phat(int fractional)
+{
+    static const double integer_delays[] = {-GCC_DELAY, GCC_DELAY};
+    static const double fractional_delays[] = {-5.75, -2.5, -0.25, 0.4, 3.25, 6.6};
+    const double *delays = fractional ? fractional_delays : integer_delays;
+    int num_delays = fractional ? (int)(sizeof(fractional_delays) / sizeof(fractional_delays[0]))
+                                : (int)(sizeof(integer_delays) / sizeof(integer_delays[0]));
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    gcc_phat_t *gcc = gcc_phat_create(&arena, GCC_BLOCK, GCC_MAX_LAG);
+    if (!gcc)
+        return no_memory(mark);
+    const float *noise = signals[3];
+    const float *x = noise + GCC_MAX_LAG;
+
+    for (int d = 0; d < num_delays; d++) {
+        double delay = delays[d];
+        const float *y;
+        if (fractional) {
+            fractional_delay(x, scratch, GCC_BLOCK, delay);
+            y = scratch;
+        } else {
+            y = x - (int)delay;                             // y[n] = x[n - delay]
+        }
+
+        gcc_phat_result_t res;
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            double t0 = now_ns();
+            gcc_phat_estimate(gcc, x, y, &res);
+            best = fmin(best, now_ns() - t0);
+        }
+        double e = fabs(res.lag - delay);
+        double ns = best / GCC_BLOCK;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+// Bins 0 .. N/2 después de toda la señal contra la DFT de las últimas N muestras
+static bench_result_t bench_sdft(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    int bins = SDFT_N / 2 + 1;
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        const float *x = signals[s];
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+            sdft_t *sdft = sdft_create(&arena, SDFT_N, bins, SDFT_DEFAULT_DAMPING);
+            if (!sdft)
+                return no_memory(mark);
+            double t0 = now_ns();
+            sdft_process(sdft, x, N_SIGNAL);
+            best = fmin(best, now_ns() - t0);
+            memcpy(out, sdft->bins, 2 * bins * sizeof(float));
+            dsp_arena_rollback(&arena, mark);
+        }
+
+        ref_dft(x + N_SIGNAL - SDFT_N, SDFT_N, 0);
+        double e = rel_error(out, 0, 2 * bins, 1.0);
+        double ns = best / N_SIGNAL;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    return r;
+}
+
+// Seno de amplitud 0.5 y frecuencia f por el banco, OCTAVE_WINDOWS ventanas;
+// devuelve el mejor tiempo de una ventana
+static double octave_tone(octave_bank_t *bank, double f)
+{
+    float *tone = scratch;
+    double best = 1e30;
+    octave_bank_reset(bank);
+    for (int w = 0; w < OCTAVE_WINDOWS; w++) {
+        for (int n = 0; n < OCTAVE_WINDOW; n++)
+            tone[n] = 0.5f * (float)sin(2.0 * M_PI * f * (n + w * OCTAVE_WINDOW));
+        double t0 = now_ns();
+        octave_bank_process(bank, tone, OCTAVE_WINDOW);
+        best = fmin(best, now_ns() - t0);
+    }
+    return best;
+}
+
+// Amplitud relativa al tono que deja pasar una banda
+static double octave_leak(const octave_bank_t *bank, int band)
+{
+    return pow(10.0, octave_bank_level_db(bank, band, 0.5f) / 20.0);
+}
+
+// mode 0: error en dB del nivel de un seno en el centro de la banda.
+// mode 1: fuga del mismo seno en las bandas vecinas.
+// mode 2: senos entre 3fs/8 y fs/2 que al ÷2 se pliegan justo sobre el
+// centro de las bandas 11, 8 y 5; fuga en las octavas de abajo de la
+// primera (ahí todo lo que aparezca es alias).
+static bench_result_t bench_octave(int mode)
+{
+    static const int bands[] = {14, 7, 1};
+    static const double alias_hz[] = {0.4, 0.45, 0.475};
+    int num_tones = mode == 2 ? (int)(sizeof(alias_hz) / sizeof(alias_hz[0]))
+                              : (int)(sizeof(bands) / sizeof(bands[0]));
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    octave_bank_t *bank = octave_bank_create(&arena, 1.0f, 0.2f, OCTAVE_OCTAVES, 3, OCTAVE_WINDOW);
+    if (!bank)
+        return no_memory(mark);
+
+    for (int t = 0; t < num_tones; t++) {
+        double f = mode == 2 ? alias_hz[t] : bank->center_hz[bands[t]];
+        double ns = octave_tone(bank, f) / OCTAVE_WINDOW;
+        double e = 0.0;
+        if (mode == 0) {
+            e = fabs(octave_bank_level_db(bank, bands[t], 0.5f));
+        } else if (mode == 1) {
+            for (int b = bands[t] - 1; b <= bands[t] + 1; b += 2)
+                if (b >= 0 && b < bank->num_bands)
+                    e = fmax(e, octave_leak(bank, b));
+        } else {
+            for (int b = 0; b < bank->num_bands - bank->fraction; b++)
+                e = fmax(e, octave_leak(bank, b));
+        }
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    dsp_arena_rollback(&arena, mark);
+    return r;
+}
+
+// Canal c de la entrada intercalada: las señales patrón con distinta escala
+static float sos_input(int c, int n)
+{
+    return signals[c % NUM_SIGNALS][n] * (1.0f + c / NUM_SIGNALS);
+}
+
+// sos_multi contra SOS_CHANNELS instancias de iir_sos_filter con la misma
+// entrada. mode 0: máxima diferencia por muestra (misma ecuación y orden de
+// operaciones, tiene que dar 0) y ns por muestra de cada canal. mode 1:
+// tiempo de sos_multi sobre el de las instancias escalares (< 1 si rinde) y
+// ns por muestra de las escalares.
+static bench_result_t bench_sos_multi(int mode)
+{
+    float *multi = scratch;
+    float *scalar = out;
+    bench_result_t r = {0.0, 0.0};
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    sos_multi_t *m = sos_multi_create(&arena, iir_sos_coeffs_x, iir_sos_coeffs_y, iir_sos_gain,
+                                      NUM_SOS, SOS_CHANNELS);
+    if (!m)
+        return no_memory(mark);
+    iir_sos_state_t *iir[SOS_CHANNELS];
+    for (int c = 0; c < SOS_CHANNELS; c++) {
+        iir[c] = iir_sos_create(&arena, iir_sos_coeffs_x, iir_sos_coeffs_y, iir_sos_gain, NUM_SOS);
+        if (!iir[c])
+            return no_memory(mark);
+    }
+
+    double best_multi = 1e30;
+    for (int rep = 0; rep < REPEATS; rep++) {
+        for (int n = 0; n < SOS_SAMPLES; n++) {
+            for (int c = 0; c < SOS_CHANNELS; c++)
+                multi[n * SOS_CHANNELS + c] = sos_input(c, n);
+        }
+        sos_multi_reset(m);
+        double t0 = now_ns();
+        sos_multi_process(m, multi, multi, SOS_SAMPLES);
+        best_multi = fmin(best_multi, now_ns() - t0);
+    }
+
+    // Un canal por vez en out, contra la salida de sos_multi que quedó en scratch
+    double best_scalar = 1e30;
+    for (int rep = 0; rep < REPEATS; rep++) {
+        double elapsed = 0.0;
+        for (int c = 0; c < SOS_CHANNELS; c++) {
+            for (int n = 0; n < SOS_SAMPLES; n++)
+                scalar[n] = sos_input(c, n);
+            iir_sos_reset(iir[c]);
+            double t0 = now_ns();
+            for (int n = 0; n < SOS_SAMPLES; n++)
+                scalar[n] = iir_sos_filter(iir[c], scalar[n]);
+            elapsed += now_ns() - t0;
+            for (int n = 0; n < SOS_SAMPLES; n++)
+                r.err = fmax(r.err, fabs((double)scalar[n] - multi[n * SOS_CHANNELS + c]));
+        }
+        best_scalar = fmin(best_scalar, elapsed);
+    }
+    dsp_arena_rollback(&arena, mark);
+
+    if (mode == 0) {
+        r.ns = best_multi / ((double)SOS_SAMPLES * SOS_CHANNELS);
+    } else {
+        r.err = best_multi / best_scalar;
+        r.ns = best_scalar / ((double)SOS_SAMPLES * SOS_CHANNELS);
+    }
+    return r;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil q de las últimas window muestras (ceros antes del inicio)
+// ordenando cada ventana, con la misma interpolación que medianFilter.h
+static void ref_median(const float *x, int window, float percentile)
+{
+    double sorted[MEDIAN_MAX_REF];
+    float position = percentile * (window - 1);
+    int rank = (int)position;
+    double frac = rank < window - 1 ? position - rank : 0.0;
+    for (int n = 0; n < N_SIGNAL; n++) {
+        for (int k = 0; k < window; k++)
+            sorted[k] = (n - k >= 0) ? x[n - k] : 0.0;
+        qsort(sorted, window, sizeof(double), compare_doubles);
+        ref[n] = sorted[rank];
+        if (frac > 0.0)
+            ref[n] += frac * (sorted[rank + 1] - sorted[rank]);
+    }
+}
+
+static bench_result_t bench_median(int window, float percentile)
+{
+    bench_result_t r = {0.0, 0.0};
+
+    for (int s = 0; s < NUM_SIGNALS; s++) {
+        const float *x = signals[s];
+        double best = 1e30;
+        for (int rep = 0; rep < REPEATS; rep++) {
+            dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+            median_filter_t *m = median_filter_create(&arena, window, percentile);
+            if (!m)
+                return no_memory(mark);
+            double t0 = now_ns();
+            median_filter_process(m, x, out, N_SIGNAL);
+            best = fmin(best, now_ns() - t0);
+            dsp_arena_rollback(&arena, mark);
+        }
+
+        ref_median(x, window, percentile);
+        double e = rel_error(out, 0, N_SIGNAL, 1.0);
+        double ns = best / N_SIGNAL;
+        if (e > r.err) r.err = e;
+        if (ns > r.ns) r.ns = ns;
+    }
+    return r;
+}
+
+static bench_result_t worst_of(bench_result_t a, bench_result_t b)
+{
+    bench_result_t r = {fmax(a.err, b.err), fmax(a.ns, b.ns)};
+    return r;
+}
+
+// Principio 0/1: una red de comparadores ordena cualquier entrada si ordena
+// todas las de ceros y unos. Error = entradas de 0/1 que quedan desordenadas
+// en alguna de las redes de 2 a MEDIAN_NETWORK_MAX.
+static bench_result_t bench_median_network(void)
+{
+    bench_result_t r = {0.0, 0.0};
+    median_filter_t m;
+    float workspace[3 * MEDIAN_NETWORK_MAX];
+    float w[MEDIAN_NETWORK_MAX];
+
+    for (int window = 2; window <= MEDIAN_NETWORK_MAX; window++) {
+        if (median_filter_init(&m, window, 0.5f, workspace) != 0 || m.num_comparators == 0) {
+            r.err = INFINITY;
+            return r;
+        }
+        for (uint32_t bits = 0; bits < (1u << window); bits++) {
+            for (int i = 0; i < window; i++)
+                w[i] = (float)((bits >> i) & 1);
+            for (int c = 0; c < m.num_comparators; c++) {
+                int i = m.comparators[c][0], j = m.comparators[c][1];
+                float a = w[i], b = w[j];
+                w[i] = a < b ? a : b;
+                w[j] = a > b ? a : b;
+            }
+            for (int i = 1; i < window; i++) {
+                if (w[i - 1] > w[i]) {
+                    r.err += 1.0;
+                    break;
+                }
+            }
+        }
+    }
+    return r;
+}
+
+// Sink de adc_recorder sobre un buffer en RAM
+typedef struct {
+    uint8_t *data;
+    size_t size, capacity;
+} capture_buffer_t;
+
+static size_t capture_write(const void *data, size_t len, void *ctx)
+{
+    capture_buffer_t *b = ctx;
+    if (b->capacity - b->size < len)
+        return 0;
+    memcpy(b->data + b->size, data, len);
+    b->size += len;
+    return len;
+}
+
+static uint16_t capture_code(uint32_t i)
+{
+    return (uint16_t)((i * 2654435761u) >> 20) & 0x0FFF;
+}
+
+// Lee toda la captura y cuenta las muestras que no coinciden con
+// capture_code (o -1 si el lector falla). *end = resultado del último next.
+static int capture_check(const uint8_t *data, size_t size, uint16_t *codes, int *end)
+{
+    adc_capture_reader_t reader;
+    if (adc_capture_reader_open(&reader, data, size) != 0)
+        return -1;
+    adc_capture_block_t block;
+    uint32_t total = 0, seq = 0;
+    int errors = 0;
+    while ((*end = adc_capture_reader_next(&reader, &block)) == 1) {
+        const uint16_t *v = block.payload;
+        if (reader.header->format == ADC_CAPTURE_PACKED12) {
+            adc_capture_unpack12(block.payload, codes, block.num_samples);
+            v = codes;
+        }
+        // El bloque entero tiene que estar dentro de los size bytes
+        size_t payload = adc_capture_payload_size(reader.header->format, block.num_samples);
+        if ((const uint8_t *)block.payload + payload > data + size || block.seq != seq++)
+            errors++;
+        for (uint32_t i = 0; i < block.num_samples; i++)
+            errors += v[i] != capture_code(total + i);
+        total += block.num_samples;
+    }
+    return errors + (*end == 0 && total != CAPTURE_SAMPLES);
+}
+
+// Error = verificaciones que fallan: pack12/unpack12 con cantidades pares e
+// impares, ida y vuelta grabador -> lector en los dos formatos, capturas
+// cortadas en cualquier byte (el lector tiene que dar -1 salvo justo en el
+// borde de un bloque) y cabeceras dañadas. ns por muestra de la lectura de
+// la captura empaquetada.
+static bench_result_t bench_capture(void)
+{
+    static const uint8_t channel_map[2] = {6, 7};
+    bench_result_t r = {0.0, 0.0};
+    uint16_t codes[CAPTURE_BLOCK];
+    uint8_t packed[CAPTURE_BLOCK * 2];
+    uint16_t unpacked[CAPTURE_BLOCK];
+    int end;
+
+    for (uint32_t n = 1; n <= 9; n++) {
+        for (uint32_t i = 0; i < n; i++)
+            codes[i] = i & 1 ? 0x0FFF : capture_code(i);
+        memset(packed, 0xA5, sizeof(packed));
+        adc_capture_pack12(codes, packed, n);
+        adc_capture_unpack12(packed, unpacked, n);
+        for (uint32_t i = 0; i < n; i++)
+            r.err += unpacked[i] != codes[i];
+        // No escribe más allá de (3n + 1) / 2 bytes
+        r.err += packed[(3 * n + 1) / 2] != 0xA5;
+    }
+
+    for (int format = ADC_CAPTURE_PACKED12; format <= ADC_CAPTURE_INT16; format++) {
+        dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+        capture_buffer_t buffer = {(uint8_t *)scratch, 0, sizeof(scratch)};
+        adc_recorder_t *rec = adc_recorder_create(&arena, 25000, channel_map, 2, format,
+                                                  CAPTURE_BLOCK, capture_write, &buffer);
+        if (!rec)
+            return no_memory(mark);
+        for (uint32_t i = 0; i < CAPTURE_SAMPLES; i++)
+            r.err += adc_recorder_push(rec, capture_code(i)) != 0;
+        r.err += adc_recorder_flush(rec) != 0;
+        dsp_arena_rollback(&arena, mark);
+
+        const uint8_t *data = buffer.data;
+        int errors = capture_check(data, buffer.size, codes, &end);
+        r.err += errors != 0 || end != 0;
+
+        if (format == ADC_CAPTURE_PACKED12) {
+            double best = 1e30;
+            for (int rep = 0; rep < REPEATS; rep++) {
+                double t0 = now_ns();
+                capture_check(data, buffer.size, codes, &end);
+                best = fmin(best, now_ns() - t0);
+            }
+            r.ns = best / CAPTURE_SAMPLES;
+        }
+
+        // Cortada: nunca entrega un bloque incompleto
+        for (size_t cut = 0; cut < buffer.size; cut++) {
+            errors = capture_check(data, cut, codes, &end);
+            if (cut < sizeof(adc_capture_header_t))
+                r.err += errors != -1;
+            else if (end == 0)
+                r.err += (cut - sizeof(adc_capture_header_t)) %
+                         (sizeof(adc_capture_block_header_t) +
+                          adc_capture_payload_size(format, CAPTURE_BLOCK)) != 0;
+            else
+                r.err += end != -1 || errors > 0;
+        }
+
+        // Dañada: num_samples del primer bloque, magic, header_size, block_samples
+        uint8_t *bytes = buffer.data;
+        adc_capture_header_t *h = (adc_capture_header_t *)bytes;
+        adc_capture_block_header_t *bh = (adc_capture_block_header_t *)(bytes + sizeof(*h));
+        adc_capture_reader_t reader;
+        adc_capture_block_t block;
+        bh->num_samples = CAPTURE_BLOCK + 1;
+        r.err += adc_capture_reader_open(&reader, data, buffer.size) != 0 ||
+                 adc_capture_reader_next(&reader, &block) != -1;
+        bh->num_samples = CAPTURE_BLOCK;
+        h->magic ^= 1;
+        r.err += capture_check(data, buffer.size, codes, &end) != -1;
+        h->magic ^= 1;
+        h->header_size += 2;
+        r.err += capture_check(data, buffer.size, codes, &end) != -1;
+        h->header_size -= 2;
+        h->block_samples = 0;
+        r.err += capture_check(data, buffer.size, codes, &end) != -1;
+        h->block_samples = CAPTURE_BLOCK;
+        r.err += capture_check(data, buffer.size, codes, &end) != 0;
+
+        // INT16 se lee sin copiar: desalineado se rechaza
+        if (format == ADC_CAPTURE_INT16) {
+            memmove(bytes + 1, bytes, buffer.size);
+            r.err += capture_check(data + 1, buffer.size, codes, &end) != -1;
+        }
+    }
+    return r;
+}
+
+// Casos con parámetros, con la firma de bench_limit_t
+static bench_result_t bench_fft_radix2(void) { return bench_fft(0); }
+static bench_result_t bench_fft_plan(void) { return bench_fft(1); }
+static bench_result_t bench_fft_real(void) { return bench_fft(2); }
+static bench_result_t bench_fft_split(void) { return bench_fft(3); }
+static bench_result_t bench_fir_f32(void) { return bench_filter(0); }
+static bench_result_t bench_fir_q15(void) { return bench_filter(1); }
+static bench_result_t bench_fir_direct(void) { return bench_filter(2); }
+static bench_result_t bench_fir_fast(void) { return bench_filter(3); }
+static bench_result_t bench_iir_direct(void) { return bench_filter(4); }
+static bench_result_t bench_iir_sos(void) { return bench_filter(5); }
+static bench_result_t bench_nlms(void) { return bench_lms(0); }
+static bench_result_t bench_fblms(void) { return bench_lms(1); }
+static bench_result_t bench_fast_db(void) { return bench_spectral(0); }
+static bench_result_t bench_features(void) { return bench_spectral(1); }
+static bench_result_t bench_peak_freq(void) { return bench_spectral_peaks(0); }
+static bench_result_t bench_peak_level(void) { return bench_spectral_peaks(1); }
+static bench_result_t bench_gcc_integer(void) { return bench_gcc_phat(0); }
+static bench_result_t bench_gcc_fractional(void) { return bench_gcc_phat(1); }
+static bench_result_t bench_octave_center(void) { return bench_octave(0); }
+static bench_result_t bench_octave_adjacent(void) { return bench_octave(1); }
+static bench_result_t bench_octave_alias(void) { return bench_octave(2); }
+static bench_result_t bench_sos_exact(void) { return bench_sos_multi(0); }
+static bench_result_t bench_sos_speedup(void) { return bench_sos_multi(1); }
+static bench_result_t bench_median_small(void) { return bench_median(MEDIAN_SMALL, 0.5f); }
+static bench_result_t bench_median_large(void) { return bench_median(MEDIAN_LARGE, 0.5f); }
+// Par: promedio de los dos del medio
+static bench_result_t bench_median_even(void)
+{
+    return worst_of(bench_median(MEDIAN_NETWORK_MAX, 0.5f), bench_median(MEDIAN_MAX_REF, 0.5f));
+}
+// Percentiles con y sin interpolación entre rangos
+static bench_result_t bench_percentile(void)
+{
+    bench_result_t r = worst_of(bench_median(MEDIAN_SMALL, 0.9f), bench_median(MEDIAN_LARGE, 0.1f));
+    r = worst_of(r, bench_median(MEDIAN_NETWORK_MAX, 0.25f));
+    return worst_of(r, bench_median(MEDIAN_MAX_REF - 8, 0.75f));
+}
+// -------------------- CASOS --------------------
+
+// -------------------- LÍMITES --------------------
+// max_err: error RMS relativo a la referencia (peor señal).
+// fft_plan es dsps_fft2r_fc32 en la placa; en el host cae en la misma
+// versión portable que fft_radix2.
+// max_ns: ns por muestra en el host (mejor de REPEATS corridas, peor señal),
+// medidos en un x86-64 con -O2 y con ~4x de margen (las IIR son lentas con el
+// impulso por los subnormales); 0 = sólo se reporta. En la placa no se aplica,
+// pero sos_speedup sí: su error es un cociente de tiempos en la misma máquina.
+typedef struct {
+    const char *name;
+    bench_result_t (*run)(void);
+    double max_err;
+    double max_ns;
+} bench_limit_t;
+
+static const bench_limit_t limits[] = {
+    {"fft_radix2",  bench_fft_radix2,   1e-6,   20.0},
+    {"fft_plan",    bench_fft_plan,     1e-6,   20.0},
+    {"fft_real",    bench_fft_real,     1e-6,   20.0},
+    {"fft_split",   bench_fft_split,    1e-6,  100.0},    // fft() de fftSplit.c, la de fftImpl.c (cos/sin por mariposa)
+    {"czt_dft",     bench_czt,          1e-5,  200.0},
+    {"czt_zoom",    bench_czt_zoom,     1e-5,  200.0},
+    {"fir_f32",     bench_fir_f32,      1e-6,   40.0},
+    {"fir_q15",     bench_fir_q15,      5e-4,   40.0},
+    {"fir_direct",  bench_fir_direct,   1e-5,  600.0},
+    {"fir_fast",    bench_fir_fast,     1e-5,  100.0},
+    {"iir_direct",  bench_iir_direct,   1e-5,  300.0},
+    {"iir_sos",     bench_iir_sos,      1e-5,  500.0},
+    {"cic",         bench_cic,          1e-6,   20.0},
+    {"cic_comp",    bench_cic_comp,     0.25,   40.0},    // error en dB de la banda de paso compensada
+    {"nlms",        bench_nlms,         1e-5,  100.0},
+    {"fblms",       bench_fblms,        1e-5,  100.0},
+    {"fast_db",     bench_fast_db,      3e-3,   20.0},    // error en dB, no relativo
+    {"spectral",    bench_features,     1e-5,   40.0},
+    {"peak_freq",   bench_peak_freq,    0.05,   40.0},    // error en bins de la frecuencia interpolada
+    {"peak_level",  bench_peak_level,   0.5,    40.0},    // error en dB del nivel interpolado
+    {"gcc_phat",    bench_gcc_integer,  1e-2,  250.0},    // error en muestras de lag
+    {"gcc_frac",    bench_gcc_fractional, 0.2, 250.0},    // sesgo de la parábola (gccPhat.h)
+    {"sdft",        bench_sdft,         1e-3,  150.0},
+    {"octave_bank", bench_octave_center, 0.2,  400.0},    // error en dB del nivel de la banda
+    {"octave_adj",  bench_octave_adjacent, 0.2, 400.0},   // amplitud relativa en las bandas vecinas (-14 dB)
+    {"octave_alias", bench_octave_alias, 3e-3, 400.0},    // amplitud relativa del alias (-50 dB, octaveBank.h)
+    {"sos_multi",   bench_sos_exact,    0.0,   100.0},    // diferencia con iir_sos por canal; ns por muestra de cada canal
+    {"sos_speedup", bench_sos_speedup,  0.9,   500.0},    // tiempo relativo a iir_sos por canal; ns de iir_sos
+    {"median_net",  bench_median_small, 1e-6,  120.0},
+    {"median_heap", bench_median_large, 1e-6,  150.0},
+    {"median_even", bench_median_even,  1e-6,  150.0},
+    {"percentile",  bench_percentile,   1e-6,  150.0},
+    {"median_0_1",  bench_median_network, 0.0,   0.0},    // entradas de 0/1 mal ordenadas
+    {"capture",     bench_capture,      0.0,   20.0},     // verificaciones de adcCapture que fallan
+};
+#define NUM_LIMITS ((int)(sizeof(limits) / sizeof(limits[0])))
+// -------------------- LÍMITES --------------------
+
+static int run_bench(void)
+{
+    int failures = 0;
+
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    generate_signals();
+
+    printf("señales: ");
+    for (int s = 0; s < NUM_SIGNALS; s++)
+        printf("%s%s", signal_names[s], s + 1 < NUM_SIGNALS ? ", " : "\n");
+    printf("%-12s %12s %10s %12s %10s\n", "kernel", "error", "limite", "ns/muestra", "limite");
+
+    for (int i = 0; i < NUM_LIMITS; i++) {
+        const bench_limit_t *lim = &limits[i];
+#ifdef ESP_PLATFORM
+        double max_ns = 0.0;
+#else
+        double max_ns = lim->max_ns;
+#endif
+        bench_result_t r = lim->run();
+        int ok = r.err <= lim->max_err && (max_ns == 0.0 || r.ns <= max_ns);
+        printf("%-12s %12.3e %10.1e %12.1f %10.1f  %s\n", lim->name, r.err, lim->max_err,
+               r.ns, max_ns, ok ? "OK" : "FALLA");
+        if (!ok)
+            failures++;
+    }
+
+    printf("%d de %d kernels fuera de límite\n", failures, NUM_LIMITS);
+    dsp_arena_report(&arena, "dspBench");
+    return failures;
+}
+
+#ifdef ESP_PLATFORM
+void app_main(void)
+{
+    run_bench();
+}
+#else
+int main(void)
+{
+    return run_bench() ? 1 : 0;
+}
+#endif
@@ -0,0 +1,196 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+#include <math.h>
+
+#include "esp_timer.h"
+
+#include "chirpZ.h"
+#include "dspArena.h"
+
+
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             1024
+#define ADC_FRAME_SIZE              4
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            50000
+#define ADC_CHANNEL_HZ              (ADC_FRECUENCY_HZ / 2)  // se analiza sólo ch6 (result[0])
+#define DAC_CHAN                    DAC_CHAN_0
+#define N_CZT 600          // muestras por bloque (no hace falta potencia de 2)
+#define M_ZOOM 64          // bins del zoom
+#define ZOOM_LOW_HZ 2000.0
+#define ZOOM_HIGH_HZ 3000.0
+#define N_PADDED 2048      // FFT con ceros para comparar tiempos
+#define LED_PIN GPIO_NUM_2   // Cambialo por el pin que quieras usar
+
+
+static const char *TAG = "ADC_CZT";
+
+static adc_channel_t channel[2] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+dac_oneshot_handle_t DAC_handle;
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+void dac_init(void)
+{
+    dac_oneshot_config_t dac_config = {
+        .chan_id = DAC_CHAN,
+    };
+    dac_oneshot_new_channel(&dac_config, &DAC_handle);
+}
+
+void init_gpio()
+{
+    // Configurar el GPIO como salida
+    gpio_config_t io_conf = {
+        .pin_bit_mask = (1ULL << LED_PIN),
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    gpio_config(&io_conf);
+}
+
+// -------------------- ZOOM CHIRP-Z --------------------
+#define DSP_ARENA_SIZE (72 * 1024)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
+void print_zoom(float data[], int M)
+{
+    float step = (ZOOM_HIGH_HZ - ZOOM_LOW_HZ) / (M - 1);
+    for (int k = 0; k < M; k++) {
+        printf("%10.1f	%10.4f\n", ZOOM_LOW_HZ + k * step, hypotf(data[2 * k], data[2 * k + 1]));
+    }
+}
+// -------------------- ZOOM CHIRP-Z --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+
+    // Chirps precalculados una sola vez
+    czt_plan_t *czt = czt_create_zoom(&arena, N_CZT, M_ZOOM, ZOOM_LOW_HZ, ZOOM_HIGH_HZ, ADC_CHANNEL_HZ);
+    float *input_real = dsp_arena_alloc_floats(&arena, N_CZT, "czt_input");
+    float *zoom = dsp_arena_alloc_floats(&arena, 2 * M_ZOOM, "czt_zoom");
+    fft_plan_t *padded = fft_plan_create(&arena, N_PADDED);
+    float *padded_data = dsp_arena_alloc_floats(&arena, 2 * N_PADDED, "fft_padded");
+    dsp_arena_report(&arena, "fftCZT");
+    if (!czt || !input_real || !zoom || !padded || !padded_data) {
+        ESP_LOGE(TAG, "DSP_ARENA_SIZE insuficiente");
+        return;
+    }
+
+    dac_init();
+    continuous_adc_init();
+
+    //descomentar para medir el tiempo de czt
+    //init_gpio();
+
+    int count = 0;
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+            adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[0];
+            uint32_t data = ADC_GET_DATA(p); // 12 bits (0–4095)
+
+            input_real[count] = (float)data / 4095.0f;
+
+            if(count == (N_CZT-1) ) {
+                //descomentar para medir el tiempo de czt
+                //gpio_set_level(LED_PIN, 1);
+
+                int64_t t0 = esp_timer_get_time();
+                czt_compute_real(czt, input_real, zoom);
+                int64_t t_czt = esp_timer_get_time() - t0;
+
+                //descomentar para medir el tiempo de czt
+                //gpio_set_level(LED_PIN, 0);
+
+                // Misma zona con una FFT rellenada con ceros (resolución más gruesa)
+                for (int i = 0; i < N_PADDED; i++) {
+                    padded_data[2 * i] = (i < N_CZT) ? input_real[i] : 0.0f;
+                    padded_data[2 * i + 1] = 0.0f;
+                }
+                t0 = esp_timer_get_time();
+                fft_plan_forward(padded, padded_data);
+                int64_t t_fft = esp_timer_get_time() - t0;
+
+                ESP_LOGI(TAG, "Zoom %.0f-%.0f Hz, %d bins: czt %d us, fft %d puntos %d us",
+                         ZOOM_LOW_HZ, ZOOM_HIGH_HZ, M_ZOOM, (int)t_czt, N_PADDED, (int)t_fft);
+                print_zoom(zoom, M_ZOOM);
+
+                count = 0;
+            } else {
+                count++;
+            }
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
@@ -13,6 +13,10 @@
 #include <sys/types.h>
 #include <math.h>
 
+#include "dspArena.h"
+#include "fftSplit.h"
+#include "slidingDft.h"
+
 #define ADC_UNIT                    ADC_UNIT_1
 #define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
 #define ADC_ATTEN                   ADC_ATTEN_DB_12
@@ -94,88 +98,29 @@ void init_gpio()
     gpio_config(&io_conf);
 }
 
-// -------------------- IMPLEMENTATION FFT--------------------
-// bit-reversal
-void rearrange(float data_re[], float data_im[], int N) {
-    int j = 0;
-    for (int i = 1; i < N; i++) {
-        int bit = N >> 1;
-        while (j & bit) {
-            j ^= bit;
-            bit >>= 1;
-        }
-        j ^= bit;
-
-        if (i < j) {
-            // Intercambiar partes reales
-            float temp = data_re[i];
-            data_re[i] = data_re[j];
-            data_re[j] = temp;
-
-            // Intercambiar partes imaginarias
-            temp = data_im[i];
-            data_im[i] = data_im[j];
-            data_im[j] = temp;
-        }
-    }
-}
-
-// cálcula la FFT
-void compute(float data_re[], float data_im[], int N) {
-    for (int step = 2; step <= N; step *= 2) {
-        int half_step = step / 2;
-        float angle_step = -2.0 * M_PI / step;
-
-        for (int group = 0; group < N; group += step) {
-            for (int pair = 0; pair < half_step; pair++) {
-                int match = group + pair + half_step;
-                int i = group + pair;
-
-                // Calcular factores de giro (twiddle factors)
-                float angle = angle_step * pair;
-                float twiddle_re = cos(angle);
-                float twiddle_im = sin(angle);
-
-                // Multiplicación compleja: temp = data[match] * twiddle
-                float temp_re = data_re[match] * twiddle_re - data_im[match] * twiddle_im;
-                float temp_im = data_re[match] * twiddle_im + data_im[match] * twiddle_re;
-
-                // Operaciones butterfly
-                data_re[match] = data_re[i] - temp_re;
-                data_im[match] = data_im[i] - temp_im;
-                data_re[i] = data_re[i] + temp_re;
-                data_im[i] = data_im[i] + temp_im;
-            }
-        }
-    }
-}
-
-void fft(float data_re[], float data_im[], int N) {
-    rearrange(data_re, data_im, N);
-    compute(data_re, data_im, N);
-}
-
-void ifft(float data_re[], float data_im[], int N) {
-    // Conjugar la entrada
-    for (int i = 0; i < N; i++) {
-        data_im[i] = -data_im[i];
-    }
+// -------------------- DFT DESLIZANTE --------------------
+// USE_SLIDING_DFT = 0: fft() de fftSplit.c cada N_FFT muestras (como siempre)
+// USE_SLIDING_DFT = 1: espectro nuevo en cada muestra con slidingDft.c; la
+// magnitud del bin SDFT_BIN (con ventana de Hann) sale por el DAC y el
+// espectro completo se imprime cada N_FFT muestras.
+#define USE_SLIDING_DFT 0
+#define SDFT_BIN        4       // 4 * 25 kHz / 64 = 1562.5 Hz (sólo ch6)
+// -------------------- DFT DESLIZANTE --------------------
 
-    // Aplicar FFT
-    fft(data_re, data_im, N);
+// Buffers de la FFT fuera del stack de la tarea
+#define N_FFT 64
+#define DSP_ARENA_SIZE ((2 * N_FFT + 6 * N_FFT) * sizeof(float) + 256)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
 
-    // Conjugar la salida y escalar por 1/N
+void print_complex_array(float data_re[], float data_im[], int N) {
     for (int i = 0; i < N; i++) {
-        data_im[i] = -data_im[i];
-        data_re[i] /= N;
-        data_im[i] /= N;
+        printf("%10.4f	%10.4f\n", data_re[i], data_im[i]);
     }
 }
-// -------------------- IMPLEMENTATION FFT--------------------
 
-void print_complex_array(float data_re[], float data_im[], int N) {
+void print_interleaved_array(const float data[], int N) {
     for (int i = 0; i < N; i++) {
-        printf("%10.4f	%10.4f\n", data_re[i], data_im[i]);
+        printf("%10.4f	%10.4f\n", data[2 * i], data[2 * i + 1]);
     }
 }
 
@@ -191,9 +136,28 @@ void app_main(void)
     //descomentar para medir el tiempo de la fff
     //init_gpio();
 
-    float input_real[64];
-    float input_image[64];
-    int cantSample = 64;
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    float *input_real = dsp_arena_alloc_floats(&arena, N_FFT, "fft_real");
+    float *input_image = dsp_arena_alloc_floats(&arena, N_FFT, "fft_imag");
+#if USE_SLIDING_DFT
+    // Entrada real: alcanza con los bins 0 .. N/2
+    sdft_t *sdft = sdft_create(&arena, N_FFT, N_FFT / 2 + 1, SDFT_DEFAULT_DAMPING);
+    float *windowed = dsp_arena_alloc_floats(&arena, 2 * (N_FFT / 2 + 1), "sdft_hann");
+#endif
+    dsp_arena_report(&arena, "fftImpl");
+    if (!input_real || !input_image) {
+        ESP_LOGE(TAG, "DSP_ARENA_SIZE insuficiente");
+        return;
+    }
+#if USE_SLIDING_DFT
+    if (!sdft || !windowed) {
+        ESP_LOGE(TAG, "DSP_ARENA_SIZE insuficiente");
+        return;
+    }
+#endif
+
+    int cantSample = N_FFT;
     int count = 0;
 
     while (1)
@@ -207,6 +171,35 @@ void app_main(void)
 
             float normalized_sample = (float)data / 4095.0f;
 
+#if USE_SLIDING_DFT
+            //descomentar para medir el tiempo de la actualización
+            //gpio_set_level(LED_PIN, 1);
+
+            sdft_update(sdft, normalized_sample);
+
+            // Hann en frecuencia sólo para el bin de control
+            const float *c = sdft_bin(sdft, SDFT_BIN);
+            const float *l = sdft_bin(sdft, SDFT_BIN - 1);
+            const float *r = sdft_bin(sdft, SDFT_BIN + 1);
+            float re = 0.5f * c[0] - 0.25f * (l[0] + r[0]);
+            float im = 0.5f * c[1] - 0.25f * (l[1] + r[1]);
+            // Amplitud de un tono: |X_k| * 4 / N con Hann
+            float amplitude = sqrtf(re * re + im * im) * 4.0f / N_FFT;
+
+            //gpio_set_level(LED_PIN, 0);
+
+            if (amplitude > 1.0f) amplitude = 1.0f;
+            dac_oneshot_output_voltage(DAC_handle, (uint8_t)(amplitude * 255.0f));
+
+            if (++count == cantSample) {
+                ESP_LOGI(TAG, "Sliding DFT (Hann):");
+                sdft_windowed(sdft, windowed);
+                print_interleaved_array(windowed, N_FFT / 2 + 1);
+                count = 0;
+            }
+            continue;
+#endif
+
             if(count < cantSample) {
                 input_real[count] = normalized_sample;
                 input_image[count] = 0.0f ;
@@ -14,6 +14,8 @@
 #include <math.h>
 
 #include "esp_dsp.h"
+#include "dspArena.h"
+#include "spectralFeatures.h"
 
 
 #define ADC_UNIT                    ADC_UNIT_1
@@ -26,8 +28,10 @@
 #define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
 #define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
 #define ADC_FRECUENCY_HZ            50000
+#define ADC_CHANNEL_HZ              (ADC_FRECUENCY_HZ / 2)  // se analiza sólo ch6 (result[0])
 #define DAC_CHAN                    DAC_CHAN_0
 #define N_FFT 64   // FFT DE 64 PUNTOS
+#define N_PEAKS 3  // picos que se reportan
 #define LED_PIN GPIO_NUM_2   // Cambialo por el pin que quieras usar
 
 
@@ -98,12 +102,26 @@ void init_gpio()
     gpio_config(&io_conf);
 }
 
+// Buffers de la FFT fuera del stack de la tarea
+#define DSP_ARENA_SIZE ((2 * N_FFT + N_FFT / 2 + 1) * sizeof(float) + 64)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
 void print_complex_array(float data[], int N) {
     for (int i = 0; i < 2*N; i=2+i) {
         printf("%10.4f	%10.4f\n", data[i], data[i+1]);
     }
 }
 
+void print_features(const spectral_features_t *f, const float *mag2, int N, float sample_rate_hz) {
+    for (int k = 0; k <= N / 2; k++) {
+        printf("%6.0f Hz	%8.2f dB\n", (float)k * sample_rate_hz / N, spectral_fast_db(mag2[k]));
+    }
+    printf("centroide %.1f Hz, RMS %.4f\n", f->centroid_hz, f->rms);
+    for (int i = 0; i < f->num_peaks; i++) {
+        printf("pico %d: %8.1f Hz (bin %.2f) %7.2f dB\n", i, f->peaks[i].freq_hz, f->peaks[i].bin, f->peaks[i].power_db);
+    }
+}
+
 
 // -------------------- Main Loop --------------------
 void app_main(void)
@@ -120,9 +138,12 @@ void app_main(void)
      // Inicializar coeficientes FFT
      dsps_fft2r_init_fc32(NULL, N_FFT);
 
-    // Buffers alineados requeridos por esp-dsp
-    __attribute__((aligned(16))) float fft_data[2 * N_FFT];
-    __attribute__((aligned(16))) float input_real[N_FFT];
+    // Buffers alineados requeridos por esp-dsp (la arena alinea a 16)
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    float *fft_data = dsp_arena_alloc_floats(&arena, 2 * N_FFT, "fft_data");
+    float *mag2 = dsp_arena_alloc_floats(&arena, N_FFT / 2 + 1, "mag2");
+    dsp_arena_report(&arena, "fftLib");
 
     int cantSample = 64;
     int count = 0;
@@ -157,8 +178,13 @@ void app_main(void)
                 //descomentar para medir el tiempo de fft
                 //gpio_set_level(LED_PIN, 0);
 
+                // Potencia, picos, centroide y RMS en una pasada
+                spectral_features_t features;
+                spectral_features(fft_data, SPECTRAL_COMPLEX, N_FFT, ADC_CHANNEL_HZ,
+                                  N_PEAKS, mag2, &features);
+
                 ESP_LOGI(TAG, "Result fft:");
-                print_complex_array(fft_data, cantSample);
+                print_features(&features, mag2, N_FFT, ADC_CHANNEL_HZ);
 
                 count = 0;
             } else {
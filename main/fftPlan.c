@@ -0,0 +1,219 @@
+#include <math.h>
+#include "fftPlan.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_dsp.h"
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+int fft_plan_init(fft_plan_t *plan, int n, float *twiddle_buffer)
+{
+    if (n < 2 || (n & (n - 1)))
+        return -1;
+
+    plan->n = n;
+    plan->log2n = 0;
+    while ((1 << plan->log2n) < n)
+        plan->log2n++;
+
+    plan->twiddle = twiddle_buffer;
+    plan->rtwiddle = twiddle_buffer + n;
+
+    // Factores de giro calculados en double una sola vez (no en cada mariposa)
+    for (int k = 0; k < n / 2; k++) {
+        double angle = -2.0 * M_PI * k / n;
+        plan->twiddle[2 * k]     = (float)cos(angle);
+        plan->twiddle[2 * k + 1] = (float)sin(angle);
+    }
+    for (int k = 0; k <= n / 2; k++) {
+        double angle = -M_PI * k / n;
+        plan->rtwiddle[2 * k]     = (float)cos(angle);
+        plan->rtwiddle[2 * k + 1] = (float)sin(angle);
+    }
+
+    plan->use_dsps = 0;
+#ifdef ESP_PLATFORM
+    if (n <= CONFIG_DSP_MAX_FFT_SIZE) {
+        static int dsps_ready = 0;
+        if (!dsps_ready && dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK)
+            dsps_ready = 1;
+        plan->use_dsps = dsps_ready;
+    }
+#endif
+    return 0;
+}
+
+fft_plan_t *fft_plan_create(dsp_arena_t *arena, int n)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    fft_plan_t *plan = dsp_arena_alloc(arena, sizeof(*plan), 0, "fft_plan");
+    float *twiddle = dsp_arena_alloc_floats(arena, FFT_PLAN_TWIDDLE_SIZE(n), "fft_plan");
+    if (!plan || !twiddle || fft_plan_init(plan, n, twiddle) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return plan;
+}
+
+// -------------------- RADIX-2 PORTABLE --------------------
+void fft_plan_forward_radix2(const fft_plan_t *plan, float *data)
+{
+    int N = plan->n;
+
+    // bit-reversal
+    int j = 0;
+    for (int i = 1; i < N; i++) {
+        int bit = N >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            float temp = data[2 * i];
+            data[2 * i] = data[2 * j];
+            data[2 * j] = temp;
+
+            temp = data[2 * i + 1];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j + 1] = temp;
+        }
+    }
+
+    // Mariposas
+    for (int step = 2, stride = N / 2; step <= N; step *= 2, stride /= 2) {
+        int half_step = step / 2;
+
+        for (int group = 0; group < N; group += step) {
+            for (int pair = 0; pair < half_step; pair++) {
+                int i = group + pair;
+                int match = i + half_step;
+
+                float twiddle_re = plan->twiddle[2 * pair * stride];
+                float twiddle_im = plan->twiddle[2 * pair * stride + 1];
+
+                float temp_re = data[2 * match] * twiddle_re - data[2 * match + 1] * twiddle_im;
+                float temp_im = data[2 * match] * twiddle_im + data[2 * match + 1] * twiddle_re;
+
+                data[2 * match]     = data[2 * i] - temp_re;
+                data[2 * match + 1] = data[2 * i + 1] - temp_im;
+                data[2 * i]     += temp_re;
+                data[2 * i + 1] += temp_im;
+            }
+        }
+    }
+}
+// -------------------- RADIX-2 PORTABLE --------------------
+
+void fft_plan_forward(const fft_plan_t *plan, float *data)
+{
+#ifdef ESP_PLATFORM
+    if (plan->use_dsps) {
+        dsps_fft2r_fc32(data, plan->n);
+        dsps_bit_rev2r_fc32(data, plan->n);
+        return;
+    }
+#endif
+    fft_plan_forward_radix2(plan, data);
+}
+
+void fft_plan_inverse(const fft_plan_t *plan, float *data)
+{
+    int N = plan->n;
+    float scale = 1.0f / N;
+
+    // Conjugar la entrada
+    for (int i = 0; i < N; i++)
+        data[2 * i + 1] = -data[2 * i + 1];
+
+    fft_plan_forward(plan, data);
+
+    // Conjugar la salida y escalar por 1/N
+    for (int i = 0; i < N; i++) {
+        data[2 * i]     *= scale;
+        data[2 * i + 1] *= -scale;
+    }
+}
+
+// -------------------- TRANSFORMADA REAL --------------------
+// z[k] = x[2k] + i*x[2k+1] ya está en memoria con el formato intercalado,
+// así que alcanza con una FFT compleja de n puntos y un paso de separación.
+void fft_plan_forward_real(const fft_plan_t *plan, float *data)
+{
+    int N = plan->n;
+
+    fft_plan_forward(plan, data);
+
+    float z0_re = data[0];
+    float z0_im = data[1];
+    data[0] = z0_re + z0_im;    // X[0]
+    data[1] = z0_re - z0_im;    // X[N]
+
+    for (int k = 1; k <= N / 2; k++) {
+        int j = N - k;
+        float zk_re = data[2 * k], zk_im = data[2 * k + 1];
+        float zj_re = data[2 * j], zj_im = data[2 * j + 1];
+
+        // Fe = (Z[k] + conj(Z[j])) / 2,  Fo = (Z[k] - conj(Z[j])) / 2i
+        float fe_re = 0.5f * (zk_re + zj_re);
+        float fe_im = 0.5f * (zk_im - zj_im);
+        float fo_re = 0.5f * (zk_im + zj_im);
+        float fo_im = -0.5f * (zk_re - zj_re);
+
+        float w_re = plan->rtwiddle[2 * k];
+        float w_im = plan->rtwiddle[2 * k + 1];
+        float t_re = w_re * fo_re - w_im * fo_im;
+        float t_im = w_re * fo_im + w_im * fo_re;
+
+        // X[k] = Fe + W^k Fo,  X[N-k] = conj(Fe - W^k Fo)
+        data[2 * k]     = fe_re + t_re;
+        data[2 * k + 1] = fe_im + t_im;
+        if (j != k) {
+            data[2 * j]     = fe_re - t_re;
+            data[2 * j + 1] = -(fe_im - t_im);
+        }
+    }
+}
+
+void fft_plan_inverse_real(const fft_plan_t *plan, float *data)
+{
+    int N = plan->n;
+
+    float x0 = data[0];
+    float xn = data[1];
+    data[0] = 0.5f * (x0 + xn);
+    data[1] = 0.5f * (x0 - xn);
+
+    for (int k = 1; k <= N / 2; k++) {
+        int j = N - k;
+        float xk_re = data[2 * k], xk_im = data[2 * k + 1];
+        float xj_re = data[2 * j], xj_im = data[2 * j + 1];
+
+        // Fe = (X[k] + conj(X[j])) / 2,  Fo = (X[k] - conj(X[j])) * conj(W^k) / 2
+        float fe_re = 0.5f * (xk_re + xj_re);
+        float fe_im = 0.5f * (xk_im - xj_im);
+        float d_re = 0.5f * (xk_re - xj_re);
+        float d_im = 0.5f * (xk_im + xj_im);
+
+        float w_re = plan->rtwiddle[2 * k];
+        float w_im = -plan->rtwiddle[2 * k + 1];
+        float fo_re = d_re * w_re - d_im * w_im;
+        float fo_im = d_re * w_im + d_im * w_re;
+
+        // Z[k] = Fe + i Fo,  Z[j] = conj(Fe) + i conj(Fo)
+        data[2 * k]     = fe_re - fo_im;
+        data[2 * k + 1] = fe_im + fo_re;
+        if (j != k) {
+            data[2 * j]     = fe_re + fo_im;
+            data[2 * j + 1] = -fe_im + fo_re;
+        }
+    }
+
+    fft_plan_inverse(plan, data);
+}
+// -------------------- TRANSFORMADA REAL --------------------
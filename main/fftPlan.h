@@ -0,0 +1,44 @@
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <stddef.h>
+#include "dspArena.h"
+
+// -------------------- PLAN FFT --------------------
+// FFT radix-2 de n puntos complejos, datos intercalados (re, im, re, im, ...)
+// como en esp-dsp. En la placa usa dsps_fft2r_fc32 (optimizada en ensamblador);
+// en el host, o si n supera CONFIG_DSP_MAX_FFT_SIZE, usa la versión portable
+// con factores de giro precalculados (mismo algoritmo que fftSplit.c).
+//
+// La transformada real trabaja sobre 2n muestras reales con una FFT compleja
+// de n puntos. Formato empaquetado de salida (2n floats):
+//   data[0] = X[0] (DC), data[1] = X[n] (Nyquist), data[2k], data[2k+1] = X[k]
+
+// floats que necesita el buffer de factores de giro de un plan de n puntos
+#define FFT_PLAN_TWIDDLE_SIZE(n)    (2 * (n) + 2)
+
+typedef struct {
+    int n;
+    int log2n;
+    int use_dsps;
+    float *twiddle;     // e^{-2*pi*i*k/n},  k = 0 .. n/2-1
+    float *rtwiddle;    // e^{-pi*i*k/n},    k = 0 .. n/2  (para la transformada real)
+} fft_plan_t;
+
+// twiddle_buffer: FFT_PLAN_TWIDDLE_SIZE(n) floats. Devuelve 0 si OK, -1 si n no es potencia de 2.
+int fft_plan_init(fft_plan_t *plan, int n, float *twiddle_buffer);
+// Plan + factores de giro desde la arena. NULL si no alcanza o n no sirve.
+fft_plan_t *fft_plan_create(dsp_arena_t *arena, int n);
+
+void fft_plan_forward(const fft_plan_t *plan, float *data);
+// Incluye el escalado por 1/n
+void fft_plan_inverse(const fft_plan_t *plan, float *data);
+// Siempre la versión portable (para comparar contra esp-dsp)
+void fft_plan_forward_radix2(const fft_plan_t *plan, float *data);
+
+// 2n muestras reales -> espectro empaquetado (in-place)
+void fft_plan_forward_real(const fft_plan_t *plan, float *data);
+// espectro empaquetado -> 2n muestras reales (in-place, con escalado)
+void fft_plan_inverse_real(const fft_plan_t *plan, float *data);
+
+#endif
@@ -0,0 +1,81 @@
+#include <math.h>
+#include "fftSplit.h"
+
+// -------------------- IMPLEMENTATION FFT--------------------
+// bit-reversal
+static void rearrange(float data_re[], float data_im[], int N) {
+    int j = 0;
+    for (int i = 1; i < N; i++) {
+        int bit = N >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            // Intercambiar partes reales
+            float temp = data_re[i];
+            data_re[i] = data_re[j];
+            data_re[j] = temp;
+
+            // Intercambiar partes imaginarias
+            temp = data_im[i];
+            data_im[i] = data_im[j];
+            data_im[j] = temp;
+        }
+    }
+}
+
+// cálcula la FFT
+static void compute(float data_re[], float data_im[], int N) {
+    for (int step = 2; step <= N; step *= 2) {
+        int half_step = step / 2;
+        float angle_step = -2.0 * M_PI / step;
+
+        for (int group = 0; group < N; group += step) {
+            for (int pair = 0; pair < half_step; pair++) {
+                int match = group + pair + half_step;
+                int i = group + pair;
+
+                // Calcular factores de giro (twiddle factors)
+                float angle = angle_step * pair;
+                float twiddle_re = cos(angle);
+                float twiddle_im = sin(angle);
+
+                // Multiplicación compleja: temp = data[match] * twiddle
+                float temp_re = data_re[match] * twiddle_re - data_im[match] * twiddle_im;
+                float temp_im = data_re[match] * twiddle_im + data_im[match] * twiddle_re;
+
+                // Operaciones butterfly
+                data_re[match] = data_re[i] - temp_re;
+                data_im[match] = data_im[i] - temp_im;
+                data_re[i] = data_re[i] + temp_re;
+                data_im[i] = data_im[i] + temp_im;
+            }
+        }
+    }
+}
+
+void fft(float data_re[], float data_im[], int N) {
+    rearrange(data_re, data_im, N);
+    compute(data_re, data_im, N);
+}
+
+void ifft(float data_re[], float data_im[], int N) {
+    // Conjugar la entrada
+    for (int i = 0; i < N; i++) {
+        data_im[i] = -data_im[i];
+    }
+
+    // Aplicar FFT
+    fft(data_re, data_im, N);
+
+    // Conjugar la salida y escalar por 1/N
+    for (int i = 0; i < N; i++) {
+        data_im[i] = -data_im[i];
+        data_re[i] /= N;
+        data_im[i] /= N;
+    }
+}
+// -------------------- IMPLEMENTATION FFT--------------------
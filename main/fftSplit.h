@@ -0,0 +1,15 @@
+#ifndef FFT_SPLIT_H
+#define FFT_SPLIT_H
+
+// -------------------- FFT CON PARTES SEPARADAS --------------------
+// La FFT radix-2 original de fftImpl.c: partes real e imaginaria en arrays
+// separados, factores de giro calculados con cos/sin en cada mariposa (sin
+// tablas ni memoria extra). Más lenta que fftPlan.h, que es el mismo
+// algoritmo con los factores precalculados y datos intercalados.
+// N tiene que ser potencia de 2. In-place.
+
+void fft(float data_re[], float data_im[], int N);
+// Incluye el escalado por 1/N
+void ifft(float data_re[], float data_im[], int N);
+
+#endif
@@ -12,6 +12,10 @@
 #include "hal/misc.h"
 #include <sys/types.h>
 
+#include "filterKernels.h"
+#include "latencyProbe.h"
+#include "medianFilter.h"
+
 #define ADC_UNIT                    ADC_UNIT_1
 #define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
 #define ADC_ATTEN                   ADC_ATTEN_DB_12
@@ -26,6 +30,13 @@
 #define DAC_CHAN                    DAC_CHAN_0
 #define LED_PIN GPIO_NUM_2  
 
+// 1 = medir la latencia ADC->DAC de cada marco (latencyProbe.h) y reportarla
+// cada LATENCY_REPORT_BLOCKS marcos. La entrada tiene que estar quieta para
+// detectar los impulsos de prueba.
+#define LATENCY_PROBE               0
+#define LATENCY_REPORT_BLOCKS       50000   // ~2 s
+#define LATENCY_IMPULSE_PERIOD      1000    // marcos entre impulsos
+
 
 static adc_channel_t channel[2] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
 dac_oneshot_handle_t DAC_handle;
@@ -33,13 +44,29 @@ adc_continuous_handle_t ADC_handle = NULL;
 
 int flag = 0;
 
+#if LATENCY_PROBE
+static latency_probe_t probe;
+#endif
+
 // Callback cuando se genera un marco de conversión
 static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
 {
+#if LATENCY_PROBE
+    latency_probe_isr(&probe);
+#endif
     flag = 1;
     return true;
 }
 
+#if LATENCY_PROBE
+// Callback cuando el pool está lleno y el marco se pierde
+static bool IRAM_ATTR s_pool_ovf_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    latency_probe_isr_dropped(&probe);
+    return false;
+}
+#endif
+
 static void continuous_adc_init()
 {
     adc_continuous_handle_cfg_t adc_config = {
@@ -69,6 +96,9 @@ static void continuous_adc_init()
 
     adc_continuous_evt_cbs_t cbs = {
         .on_conv_done = s_conv_done_cb,
+#if LATENCY_PROBE
+        .on_pool_ovf = s_pool_ovf_cb,
+#endif
     };
     ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
     ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
@@ -118,22 +148,14 @@ void init_gpio()
 //const float fir_coeffs[FIR_ORDER] = {-0.0077763127f, 0.0644546455f, 0.4433216671f, 0.4433216671f, 0.0644546455f, -0.0077763127f};
 const float fir_coeffs[FIR_ORDER] = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
 
-float fir_buffer[FIR_ORDER] = {0.0f};
+// 1 = mediana de las últimas MEDIAN_WINDOW muestras en lugar de la FIR: saca
+// los picos impulsivos en vez de desparramarlos como el PROMEDIO
+#define USE_MEDIAN 0
+#define MEDIAN_WINDOW 5
 
-float fir_filter(float new_sample)
-{
-    // Desplazar buffer
-    for (int i = FIR_ORDER - 1; i > 0; i--)
-        fir_buffer[i] = fir_buffer[i - 1];
-    fir_buffer[0] = new_sample;
-
-    // Convolución
-    float result = 0.0f;
-    for (int i = 0; i < FIR_ORDER; i++)
-        result += fir_coeffs[i] * fir_buffer[i];
-
-    return result;
-}
+// Estado del filtro (fir_filter en filterKernels.c, median_filter en medianFilter.c)
+#define DSP_ARENA_SIZE 512
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
 // -------------------- FIR --------------------
 
 
@@ -143,6 +165,29 @@ void app_main(void)
     uint8_t result[ADC_FRAME_SIZE] = {0};
     uint32_t ret_num = 0;
 
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+#if USE_MEDIAN
+    median_filter_t *median = median_filter_create(&arena, MEDIAN_WINDOW, 0.5f);
+    dsp_arena_report(&arena, "filterFIR");
+    if (!median)
+        return;
+#else
+    fir_state_t *fir = fir_create(&arena, fir_coeffs, FIR_ORDER);
+    dsp_arena_report(&arena, "filterFIR");
+    if (!fir)
+        return;
+#endif
+
+#if LATENCY_PROBE
+    // Un marco = ADC_FRAME_SIZE bytes de conversiones a ADC_FRECUENCY_HZ
+    latency_probe_init(&probe, 1e6f * ADC_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES / ADC_FRECUENCY_HZ, 0.0f);
+    int stage_read = latency_probe_add_stage(&probe, "lectura");
+    int stage_fir = latency_probe_add_stage(&probe, "fir");
+    int stage_dac = latency_probe_add_stage(&probe, "dac");
+    latency_probe_set_impulse(&probe, LATENCY_IMPULSE_PERIOD, 1.0f, 0.1f);
+#endif
+
     dac_init();
     continuous_adc_init();
 
@@ -156,22 +201,38 @@ void app_main(void)
         if (flag)
         {
             flag = 0;
+#if LATENCY_PROBE
+            latency_probe_begin(&probe);
+#endif
             adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
             adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[0];
 
             uint32_t data = ADC_GET_DATA(p);
+#if LATENCY_PROBE
+            latency_probe_stage(&probe, stage_read);
+#endif
 
             // 1️⃣ Normalizar a 0-1
             float normalized_sample = (float)data / 4095.0f;
+#if LATENCY_PROBE
+            normalized_sample = latency_probe_inject(&probe, normalized_sample);
+#endif
 
             //descomentar para medir el tiempo de fir_filter
             //gpio_set_level(LED_PIN, 1);
 
             // 2️⃣ Aplicar FIR
-            float filtered_sample = fir_filter(normalized_sample);
+#if USE_MEDIAN
+            float filtered_sample = median_filter(median, normalized_sample);
+#else
+            float filtered_sample = fir_filter(fir, normalized_sample);
+#endif
 
             //descomentar para medir el tiempo de fir_filter
             //gpio_set_level(LED_PIN, 0);
+#if LATENCY_PROBE
+            latency_probe_stage(&probe, stage_fir);
+#endif
 
             if (!isFilterPB)
                 filtered_sample = filtered_sample + 0.5f;
@@ -184,7 +245,18 @@ void app_main(void)
             uint8_t dac_value = (uint8_t)(filtered_sample * 255.0f);
         
             // 5️⃣ Escribir al DAC
+#if LATENCY_PROBE
+            latency_probe_output(&probe, filtered_sample);
+#endif
             dac_oneshot_output_voltage(DAC_handle, dac_value);
+#if LATENCY_PROBE
+            latency_probe_stage(&probe, stage_dac);
+            latency_probe_end(&probe);
+            if (probe.blocks == LATENCY_REPORT_BLOCKS) {
+                latency_probe_report(&probe, "filterFIR");
+                latency_probe_reset(&probe);
+            }
+#endif
         }
     }
 
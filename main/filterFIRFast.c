@@ -0,0 +1,262 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+#include <math.h>
+#include "esp_timer.h"
+
+#include "firFast.h"
+
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             1024
+#define ADC_FRAME_SIZE              4
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            50000
+#define ADC_CHANNEL_HZ              (ADC_FRECUENCY_HZ / 2)  // se filtra sólo ch6 (result[0])
+
+#define DAC_CHAN                    DAC_CHAN_0
+#define LED_PIN GPIO_NUM_2  
+
+static const char *TAG = "FIR_FAST";
+
+
+static adc_channel_t channel[2] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+dac_oneshot_handle_t DAC_handle;
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+void dac_init(void)
+{
+    dac_oneshot_config_t dac_config = {
+        .chan_id = DAC_CHAN,
+    };
+    dac_oneshot_new_channel(&dac_config, &DAC_handle);
+}
+
+void init_gpio()
+{
+    // Configurar el GPIO como salida
+    gpio_config_t io_conf = {
+        .pin_bit_mask = (1ULL << LED_PIN),
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    gpio_config(&io_conf);
+}
+
+
+// -------------------- FIR LARGO (FFT) --------------------
+// FPB - fs 25KHz (ch6) - fc 2.5k, ventana de Hamming
+#define FIR_TAPS            255
+#define FIR_BLOCK           64      // latencia de la versión por FFT (muestras)
+#define DSP_ARENA_SIZE      (32 * 1024)
+
+float fir_coeffs[FIR_TAPS];
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+
+void design_lowpass(float *h, int num_taps, float fc_hz, float fs_hz)
+{
+    float fc = fc_hz / fs_hz;
+    int m = num_taps - 1;
+    for (int i = 0; i < num_taps; i++) {
+        float t = i - m / 2.0f;
+        float sinc = (t == 0.0f) ? 2.0f * fc : sinf(2.0f * M_PI * fc * t) / (M_PI * t);
+        float window = 0.54f - 0.46f * cosf(2.0f * M_PI * i / m);
+        h[i] = sinc * window;
+    }
+}
+
+// Mide ns/muestra de cada camino con la misma configuración que se va a usar
+// (bloques de block_size, una muestra por llamada como en el lazo principal)
+// y devuelve a partir de cuántos taps conviene la FFT. Se descarta una pasada
+// para llenar las particiones y se mide sobre CALIB_BLOCKS bloques.
+// Primero se busca la potencia de 2 donde gana la FFT y después se bisecta
+// contra la anterior en pasos de CALIB_STEP taps.
+// Los filtros de prueba se crean en la arena y se liberan con rollback.
+#define CALIB_BLOCKS        32
+#define CALIB_MAX_TAPS      512
+#define CALIB_STEP          8
+#define CALIB_SAMPLES       (CALIB_BLOCKS * FIR_BLOCK)
+
+static float calib_in[CALIB_SAMPLES];
+
+// 1 si con taps gana la FFT, 0 si gana la directa, -1 si no entra en la arena
+static int fft_wins(dsp_arena_t *arena, int taps, int block_size)
+{
+    float out;
+    int elapsed_ns[2];
+    for (int use_fft = 0; use_fft < 2; use_fft++) {
+        dsp_arena_mark_t mark = dsp_arena_mark(arena);
+        // crossover 0 fuerza la FFT, taps+1 fuerza la forma directa
+        fir_fast_t *probe = fir_fast_create(arena, calib_in, taps, block_size, use_fft ? 0 : taps + 1);
+        if (!probe)
+            return -1;
+        for (int i = 0; i < CALIB_SAMPLES; i++)
+            fir_fast_process(probe, &calib_in[i], &out, 1);
+        int64_t t0 = esp_timer_get_time();
+        for (int i = 0; i < CALIB_SAMPLES; i++)
+            fir_fast_process(probe, &calib_in[i], &out, 1);
+        elapsed_ns[use_fft] = (int)((esp_timer_get_time() - t0) * 1000 / CALIB_SAMPLES);
+        dsp_arena_rollback(arena, mark);
+    }
+    ESP_LOGI(TAG, "taps %3d: directa %d ns/muestra, fft %d ns/muestra", taps,
+             elapsed_ns[0], elapsed_ns[1]);
+    return elapsed_ns[1] < elapsed_ns[0];
+}
+
+int calibrate_crossover(dsp_arena_t *arena, int block_size)
+{
+    for (int i = 0; i < CALIB_SAMPLES; i++)
+        calib_in[i] = (float)(i % 17) / 17.0f;
+
+    int low = 0;
+    int high = 0;
+    for (int taps = CALIB_STEP; taps <= CALIB_MAX_TAPS && !high; taps *= 2) {
+        int wins = fft_wins(arena, taps, block_size);
+        if (wins < 0)
+            return FIR_FAST_CROSSOVER_TAPS;
+        if (wins)
+            high = taps;
+        else
+            low = taps;
+    }
+    if (!high)
+        return FIR_FAST_CROSSOVER_TAPS;
+
+    // La directa gana en low y la FFT en high
+    while (high - low > CALIB_STEP) {
+        int mid = (low + high) / 2 / CALIB_STEP * CALIB_STEP;
+        int wins = fft_wins(arena, mid, block_size);
+        if (wins < 0)
+            break;
+        if (wins)
+            high = mid;
+        else
+            low = mid;
+    }
+    return high;
+}
+// -------------------- FIR LARGO (FFT) --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+
+    int crossover = calibrate_crossover(&arena, FIR_BLOCK);
+    ESP_LOGI(TAG, "Cruce directa/FFT: %d taps", crossover);
+
+    design_lowpass(fir_coeffs, FIR_TAPS, 2500.0f, ADC_CHANNEL_HZ);
+    fir_fast_t *fir = fir_fast_create(&arena, fir_coeffs, FIR_TAPS, FIR_BLOCK, crossover);
+    dsp_arena_report(&arena, "filterFIRFast");
+    if (!fir) {
+        ESP_LOGE(TAG, "DSP_ARENA_SIZE insuficiente");
+        return;
+    }
+    ESP_LOGI(TAG, "FIR de %d taps por %s, latencia %d muestras", FIR_TAPS,
+             fir->use_fft ? "FFT" : "forma directa", fir_fast_latency(fir));
+
+    dac_init();
+    continuous_adc_init();
+
+    //descomentar para medir el tiempo de fir_fast_process
+    //init_gpio();
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+            adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[0];
+
+            uint32_t data = ADC_GET_DATA(p);
+
+            // 1️⃣ Normalizar a 0-1
+            float normalized_sample = (float)data / 4095.0f;
+
+            //descomentar para medir el tiempo de fir_fast_process
+            //gpio_set_level(LED_PIN, 1);
+
+            // 2️⃣ Aplicar FIR (cada FIR_BLOCK muestras corre la FFT)
+            float filtered_sample;
+            fir_fast_process(fir, &normalized_sample, &filtered_sample, 1);
+
+            //descomentar para medir el tiempo de fir_fast_process
+            //gpio_set_level(LED_PIN, 0);
+
+            // 3️⃣ Saturar
+            if (filtered_sample < 0.0f) filtered_sample = 0.0f;
+            if (filtered_sample > 1.0f) filtered_sample = 1.0f;
+
+            // 4️⃣ Escalar a DAC 0-255 (8 bits)
+            uint8_t dac_value = (uint8_t)(filtered_sample * 255.0f);
+
+            // 5️⃣ Escribir al DAC
+            dac_oneshot_output_voltage(DAC_handle, dac_value);
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
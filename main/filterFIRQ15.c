@@ -12,6 +12,8 @@
 #include "hal/misc.h"
 #include <sys/types.h>
 
+#include "filterKernels.h"
+
 #define ADC_UNIT                    ADC_UNIT_1
 #define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
 #define ADC_ATTEN                   ADC_ATTEN_DB_12
@@ -104,30 +106,9 @@ const int16_t fir_coeffs[FIR_ORDER] = {
     (int16_t)(-0.0882352941f * 32768)
 };
 
-float fir_buffer[FIR_ORDER] = {0.0f};
-
-// -------------------- Función de filtro FIR Q15 --------------------
-int16_t fir_filter_q15(int16_t new_sample)
-{
-    // Desplazar el buffer
-    for (int i = FIR_ORDER - 1; i > 0; i--)
-        fir_buffer[i] = fir_buffer[i - 1];
-    fir_buffer[0] = new_sample;
-
-    // Convolución
-    int32_t acc = 0;
-    for (int i = 0; i < FIR_ORDER; i++)
-        acc += (int32_t)fir_coeffs[i] * (int32_t)fir_buffer[i];
-
-    // Ajustar de Q30 a Q15
-    acc = acc >> 15;
-
-    // Saturación
-    if (acc > 32767) acc = 32767;
-    if (acc < -32768) acc = -32768;
-
-    return (int16_t)acc;
-}
+// Estado del filtro (fir_filter_q15 en filterKernels.c)
+#define DSP_ARENA_SIZE 128
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
 // -------------------- FIR Q15--------------------
 
 // -------------------- Main Loop --------------------
@@ -136,6 +117,13 @@ void app_main(void)
     uint8_t result[ADC_FRAME_SIZE] = {0};
     uint32_t ret_num = 0;
 
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    fir_q15_state_t *fir = fir_q15_create(&arena, fir_coeffs, FIR_ORDER);
+    dsp_arena_report(&arena, "filterFIRQ15");
+    if (!fir)
+        return;
+
     dac_init();
     continuous_adc_init();
 
@@ -161,7 +149,7 @@ void app_main(void)
             //gpio_set_level(LED_PIN, 1);
 
             // 2️⃣ Aplicar FIR
-            int16_t filtered_sample = fir_filter_q15(input_sample);
+            int16_t filtered_sample = fir_filter_q15(fir, input_sample);
 
             //descomentar para medir el tiempo de fir_filter_q15
             //gpio_set_level(LED_PIN, 0);
@@ -12,6 +12,8 @@
 #include "hal/misc.h"
 #include <sys/types.h>
 
+#include "filterKernels.h"
+
 #define ADC_UNIT                    ADC_UNIT_1
 #define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
 #define ADC_ATTEN                   ADC_ATTEN_DB_12
@@ -86,34 +88,6 @@ void dac_init(void)
 
 float iir_coeffs_x[IIR_ORDER] = {0.0528f, 0.2640f, 0.5279f, 0.5279f, 0.2640f, 0.0528f};
 float iir_coeffs_y[IIR_ORDER] = {1.0f, 0.0f, 0.6335f, 0.0f, 0.0557f, 0.0f};
-float x_buffer[IIR_ORDER] = {0};   // entradas
-float y_buffer[IIR_ORDER] = {0};   // salidas
-
-float iir_filter(float new_sample)
-{
-    // Desplazar entradas
-    for (int i = IIR_ORDER - 1; i > 0; i--)
-        x_buffer[i] = x_buffer[i - 1];
-    x_buffer[0] = new_sample;
-
-    // Desplazar salidas
-    for (int i = IIR_ORDER - 1; i > 0; i--)
-        y_buffer[i] = y_buffer[i - 1];
-
-    float y = 0.0f;
-
-    // Parte FIR: sumatoria b[k] * x[n-k]
-    for (int i = 0; i < IIR_ORDER; i++)
-        y += iir_coeffs_x[i] * x_buffer[i];
-
-    // Parte IIR: resta a[k] * y[n-k]
-    for (int i = 1; i < IIR_ORDER; i++)
-        y -= iir_coeffs_y[i] * y_buffer[i - 1];
-
-    y_buffer[0] = y;
-
-    return y;
-}
 
 #define NUM_SOS 3
 
@@ -134,53 +108,9 @@ float iir_sos_coeffs_y[NUM_SOS][3] = {
 // Ganancias G
 float G[NUM_SOS] = {0.3820f, 0.2764f, 0.5000f};
 
-// Buffers de cada sección
-float x_sos_buffer[NUM_SOS][3] = {0};
-float y_sos_buffer[NUM_SOS][3] = {0};
-
-float iir_sos_filter(float input_sample)
-{
-    float x = input_sample;
-    float y;
-
-    for (int s = 0; s < NUM_SOS; s++)
-    {
-        float b0 = iir_sos_coeffs_x[s][0];
-        float b1 = iir_sos_coeffs_x[s][1];
-        float b2 = iir_sos_coeffs_x[s][2];
-
-        float a0 = iir_sos_coeffs_y[s][0];
-        float a1 = iir_sos_coeffs_y[s][1];
-        float a2 = iir_sos_coeffs_y[s][2];
-
-        // Recuperar historial
-        float x0 = x;
-        float x1 = x_sos_buffer[s][0];
-        float x2 = x_sos_buffer[s][1];
-
-        float y1 = y_sos_buffer[s][0];
-        float y2 = y_sos_buffer[s][1];
-
-        // Ecuación de diferencia
-        y = (b0*x0 + b1*x1 + b2*x2
-            - a1*y1 - a2*y2) / a0;
-
-        // Guardar valores en buffers
-        x_sos_buffer[s][1] = x1;
-        x_sos_buffer[s][0] = x0;
-
-        y_sos_buffer[s][1] = y1;
-        y_sos_buffer[s][0] = y;
-
-        // Aplicar ganancia de la sección
-        y *= G[s];
-
-        // La salida se convierte en entrada de la siguiente sección
-        x = y;
-    }
-
-    return y;
-}
+// Estado de los filtros (iir_filter / iir_sos_filter en filterKernels.c)
+#define DSP_ARENA_SIZE 256
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
 // -------------------- FILTER IIR --------------------
 
 // -------------------- Main Loop --------------------
@@ -189,6 +119,15 @@ void app_main(void)
     uint8_t result[ADC_FRAME_SIZE] = {0};
     uint32_t ret_num = 0;
 
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+    iir_state_t *iir = iir_create(&arena, iir_coeffs_x, iir_coeffs_y, IIR_ORDER);
+    iir_sos_state_t *iir_sos = iir_sos_create(&arena, &iir_sos_coeffs_x[0][0],
+                                              &iir_sos_coeffs_y[0][0], G, NUM_SOS);
+    dsp_arena_report(&arena, "filterIIR");
+    if (!iir || !iir_sos)
+        return;
+
     dac_init();
     continuous_adc_init();
     bool isFilterPB = true;
@@ -207,7 +146,7 @@ void app_main(void)
             float normalized_sample = (float)data / 4095.0f;
              
             // 2️⃣ Aplicar FIR
-            float filtered_sample = iir_filter(normalized_sample);
+            float filtered_sample = iir_filter(iir, normalized_sample);
 
             if (!isFilterPB)
                 filtered_sample = filtered_sample + 0.5f;
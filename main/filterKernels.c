@@ -0,0 +1,216 @@
+#include <string.h>
+#include "filterKernels.h"
+
+// -------------------- CREACIÓN --------------------
+fir_state_t *fir_create(dsp_arena_t *arena, const float *coeffs, int order)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    fir_state_t *fir = dsp_arena_alloc(arena, sizeof(*fir), 0, "fir");
+    float *buffer = dsp_arena_alloc_floats(arena, order, "fir");
+    if (!fir || !buffer) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    fir->coeffs = coeffs;
+    fir->buffer = buffer;
+    fir->order = order;
+    fir_reset(fir);
+    return fir;
+}
+
+fir_q15_state_t *fir_q15_create(dsp_arena_t *arena, const int16_t *coeffs, int order)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    fir_q15_state_t *fir = dsp_arena_alloc(arena, sizeof(*fir), 0, "fir_q15");
+    int16_t *buffer = dsp_arena_alloc(arena, order * sizeof(int16_t), 0, "fir_q15");
+    if (!fir || !buffer) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    fir->coeffs = coeffs;
+    fir->buffer = buffer;
+    fir->order = order;
+    fir_q15_reset(fir);
+    return fir;
+}
+
+iir_state_t *iir_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y, int order)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    iir_state_t *iir = dsp_arena_alloc(arena, sizeof(*iir), 0, "iir");
+    float *x_buffer = dsp_arena_alloc_floats(arena, order, "iir");
+    float *y_buffer = dsp_arena_alloc_floats(arena, order, "iir");
+    if (!iir || !x_buffer || !y_buffer) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    iir->coeffs_x = coeffs_x;
+    iir->coeffs_y = coeffs_y;
+    iir->x_buffer = x_buffer;
+    iir->y_buffer = y_buffer;
+    iir->order = order;
+    iir_reset(iir);
+    return iir;
+}
+
+iir_sos_state_t *iir_sos_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y,
+                                const float *gain, int num_sos)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    iir_sos_state_t *iir = dsp_arena_alloc(arena, sizeof(*iir), 0, "iir_sos");
+    float *x_buffer = dsp_arena_alloc_floats(arena, 2 * num_sos, "iir_sos");
+    float *y_buffer = dsp_arena_alloc_floats(arena, 2 * num_sos, "iir_sos");
+    if (!iir || !x_buffer || !y_buffer) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    iir->coeffs_x = coeffs_x;
+    iir->coeffs_y = coeffs_y;
+    iir->gain = gain;
+    iir->x_buffer = x_buffer;
+    iir->y_buffer = y_buffer;
+    iir->num_sos = num_sos;
+    iir_sos_reset(iir);
+    return iir;
+}
+
+void fir_reset(fir_state_t *fir)
+{
+    memset(fir->buffer, 0, fir->order * sizeof(float));
+}
+
+void fir_q15_reset(fir_q15_state_t *fir)
+{
+    memset(fir->buffer, 0, fir->order * sizeof(int16_t));
+}
+
+void iir_reset(iir_state_t *iir)
+{
+    memset(iir->x_buffer, 0, iir->order * sizeof(float));
+    memset(iir->y_buffer, 0, iir->order * sizeof(float));
+}
+
+void iir_sos_reset(iir_sos_state_t *iir)
+{
+    memset(iir->x_buffer, 0, 2 * iir->num_sos * sizeof(float));
+    memset(iir->y_buffer, 0, 2 * iir->num_sos * sizeof(float));
+}
+// -------------------- CREACIÓN --------------------
+
+// -------------------- FIR --------------------
+float fir_filter(fir_state_t *fir, float new_sample)
+{
+    float *fir_buffer = fir->buffer;
+
+    // Desplazar buffer
+    for (int i = fir->order - 1; i > 0; i--)
+        fir_buffer[i] = fir_buffer[i - 1];
+    fir_buffer[0] = new_sample;
+
+    // Convolución
+    float result = 0.0f;
+    for (int i = 0; i < fir->order; i++)
+        result += fir->coeffs[i] * fir_buffer[i];
+
+    return result;
+}
+// -------------------- FIR --------------------
+
+// -------------------- FIR Q15--------------------
+int16_t fir_filter_q15(fir_q15_state_t *fir, int16_t new_sample)
+{
+    int16_t *fir_buffer = fir->buffer;
+
+    // Desplazar el buffer
+    for (int i = fir->order - 1; i > 0; i--)
+        fir_buffer[i] = fir_buffer[i - 1];
+    fir_buffer[0] = new_sample;
+
+    // Convolución
+    int32_t acc = 0;
+    for (int i = 0; i < fir->order; i++)
+        acc += (int32_t)fir->coeffs[i] * (int32_t)fir_buffer[i];
+
+    // Ajustar de Q30 a Q15
+    acc = acc >> 15;
+
+    // Saturación
+    if (acc > 32767) acc = 32767;
+    if (acc < -32768) acc = -32768;
+
+    return (int16_t)acc;
+}
+// -------------------- FIR Q15--------------------
+
+// -------------------- FILTER IIR --------------------
+float iir_filter(iir_state_t *iir, float new_sample)
+{
+    float *x_buffer = iir->x_buffer;
+    float *y_buffer = iir->y_buffer;
+    int order = iir->order;
+
+    // Desplazar entradas
+    for (int i = order - 1; i > 0; i--)
+        x_buffer[i] = x_buffer[i - 1];
+    x_buffer[0] = new_sample;
+
+    // Desplazar salidas: y_buffer[i] = y[n-i]
+    for (int i = order - 1; i > 0; i--)
+        y_buffer[i] = y_buffer[i - 1];
+
+    float y = 0.0f;
+
+    // Parte FIR: sumatoria b[k] * x[n-k]
+    for (int i = 0; i < order; i++)
+        y += iir->coeffs_x[i] * x_buffer[i];
+
+    // Parte IIR: resta a[k] * y[n-k]
+    for (int i = 1; i < order; i++)
+        y -= iir->coeffs_y[i] * y_buffer[i];
+
+    y_buffer[0] = y;
+
+    return y;
+}
+
+float iir_sos_filter(iir_sos_state_t *iir, float input_sample)
+{
+    float x = input_sample;
+    float y = x;
+
+    for (int s = 0; s < iir->num_sos; s++)
+    {
+        const float *b = &iir->coeffs_x[3 * s];
+        const float *a = &iir->coeffs_y[3 * s];
+        float *xs = &iir->x_buffer[2 * s];
+        float *ys = &iir->y_buffer[2 * s];
+
+        // Recuperar historial
+        float x0 = x;
+        float x1 = xs[0];
+        float x2 = xs[1];
+
+        float y1 = ys[0];
+        float y2 = ys[1];
+
+        // Ecuación de diferencia
+        y = (b[0]*x0 + b[1]*x1 + b[2]*x2
+            - a[1]*y1 - a[2]*y2) / a[0];
+
+        // Guardar valores en buffers
+        xs[1] = x1;
+        xs[0] = x0;
+
+        ys[1] = y1;
+        ys[0] = y;
+
+        // Aplicar ganancia de la sección
+        y *= iir->gain[s];
+
+        // La salida se convierte en entrada de la siguiente sección
+        x = y;
+    }
+
+    return y;
+}
+// -------------------- FILTER IIR --------------------
@@ -0,0 +1,59 @@
+#ifndef FILTER_KERNELS_H
+#define FILTER_KERNELS_H
+
+#include <stdint.h>
+#include "dspArena.h"
+
+// -------------------- FILTROS BÁSICOS --------------------
+// Los mismos kernels de filterFIR.c, filterFIRQ15.c y filterIIR.c, con el
+// estado (buffers) en un struct en vez de globales, para poder tener varias
+// instancias (una por canal) y crearlas desde una arena.
+// Los coeficientes siguen siendo del llamador y no se copian.
+
+typedef struct {
+    const float *coeffs;
+    float *buffer;          // order muestras, buffer[0] la más nueva
+    int order;
+} fir_state_t;
+
+typedef struct {
+    const int16_t *coeffs;  // Q15
+    int16_t *buffer;
+    int order;
+} fir_q15_state_t;
+
+typedef struct {
+    const float *coeffs_x;  // b[0..order-1]
+    const float *coeffs_y;  // a[0..order-1], a[0] = 1
+    float *x_buffer;
+    float *y_buffer;
+    int order;
+} iir_state_t;
+
+typedef struct {
+    const float *coeffs_x;  // num_sos x {b0, b1, b2}
+    const float *coeffs_y;  // num_sos x {a0, a1, a2}
+    const float *gain;      // num_sos
+    float *x_buffer;        // num_sos x {x[n-1], x[n-2]}
+    float *y_buffer;        // num_sos x {y[n-1], y[n-2]}
+    int num_sos;
+} iir_sos_state_t;
+
+// Devuelven NULL si la arena no alcanza
+fir_state_t *fir_create(dsp_arena_t *arena, const float *coeffs, int order);
+fir_q15_state_t *fir_q15_create(dsp_arena_t *arena, const int16_t *coeffs, int order);
+iir_state_t *iir_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y, int order);
+iir_sos_state_t *iir_sos_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y,
+                                const float *gain, int num_sos);
+
+void fir_reset(fir_state_t *fir);
+void fir_q15_reset(fir_q15_state_t *fir);
+void iir_reset(iir_state_t *iir);
+void iir_sos_reset(iir_sos_state_t *iir);
+
+float fir_filter(fir_state_t *fir, float new_sample);
+int16_t fir_filter_q15(fir_q15_state_t *fir, int16_t new_sample);
+float iir_filter(iir_state_t *iir, float new_sample);
+float iir_sos_filter(iir_sos_state_t *iir, float input_sample);
+
+#endif
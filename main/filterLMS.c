@@ -0,0 +1,189 @@
+#include <string.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
+#include "driver/dac_continuous.h"
+#include "hal/misc.h"
+#include <sys/types.h>
+
+#include "lms.h"
+
+// Cancelación de ruido: ADC_CHANNEL_6 es la señal con ruido (primaria) y
+// ADC_CHANNEL_7 una referencia del ruido. Al DAC sale el error e = d - w*x.
+#define ADC_UNIT                    ADC_UNIT_1
+#define ADC_CONV_MODE               ADC_CONV_SINGLE_UNIT_1
+#define ADC_ATTEN                   ADC_ATTEN_DB_12
+#define ADC_BIT_WIDTH               CONFIG_SOC_ADC_DIGI_MAX_BITWIDTH
+#define ADC_BUFFER_SIZE             4096
+#define ADC_FRAME_SIZE              256     // 64 pares ch6/ch7 por lectura
+#define ADC_OUTPUT_TYPE             ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data)     ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)        ((p_data)->type1.data)
+#define ADC_FRECUENCY_HZ            100000  // 50 kHz por canal
+
+#define DAC_CHAN                    DAC_CHAN_0
+#define LED_PIN GPIO_NUM_2
+
+static const char *TAG = "FILTER_LMS";
+
+static adc_channel_t channel[2] = {ADC_CHANNEL_6, ADC_CHANNEL_7};
+dac_oneshot_handle_t DAC_handle;
+adc_continuous_handle_t ADC_handle = NULL;
+
+int flag = 0;
+
+// Callback cuando se genera un marco de conversión
+static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    flag = 1;
+    return true;
+}
+
+static void continuous_adc_init()
+{
+    adc_continuous_handle_cfg_t adc_config = {
+        .max_store_buf_size = ADC_BUFFER_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    adc_continuous_new_handle(&adc_config, &ADC_handle);
+    int channel_num = sizeof(channel) / sizeof(adc_channel_t);
+
+    adc_continuous_config_t dig_cfg = {
+        .sample_freq_hz = ADC_FRECUENCY_HZ,
+        .conv_mode = ADC_CONV_MODE,
+        .format = ADC_OUTPUT_TYPE,
+    };
+
+    adc_digi_pattern_config_t adc_pattern[SOC_ADC_PATT_LEN_MAX] = {0};
+    dig_cfg.pattern_num = channel_num;
+    for (int i = 0; i < channel_num; i++) {
+        adc_pattern[i].atten = ADC_ATTEN;
+        adc_pattern[i].channel = channel[i] & 0x7;
+        adc_pattern[i].unit = ADC_UNIT;
+        adc_pattern[i].bit_width = ADC_BIT_WIDTH;
+    }
+    dig_cfg.adc_pattern = adc_pattern;
+
+    adc_continuous_config(ADC_handle, &dig_cfg);
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = s_conv_done_cb,
+    };
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(ADC_handle, &cbs, NULL));
+    ESP_ERROR_CHECK(adc_continuous_start(ADC_handle));
+}
+
+void dac_init(void)
+{
+    dac_oneshot_config_t dac_config = {
+        .chan_id = DAC_CHAN,
+    };
+    dac_oneshot_new_channel(&dac_config, &DAC_handle);
+}
+
+
+// -------------------- LMS --------------------
+// LMS_USE_BLOCK = 0: NLMS por muestra (latencia 0, filtros cortos)
+// LMS_USE_BLOCK = 1: LMS en frecuencia (latencia LMS_TAPS, filtros largos)
+#define LMS_USE_BLOCK   1
+#if LMS_USE_BLOCK
+#define LMS_TAPS        256
+#define LMS_MU          0.2f
+#else
+#define LMS_TAPS        32
+#define LMS_MU          0.1f
+#endif
+#define LMS_REPORT_US   1000000
+
+#define MAX_PAIRS (ADC_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES / 2)
+
+#define DSP_ARENA_SIZE (20 * 1024)
+static uint8_t dsp_arena_buffer[DSP_ARENA_SIZE] __attribute__((aligned(16)));
+// -------------------- LMS --------------------
+
+
+// -------------------- Main Loop --------------------
+void app_main(void)
+{
+    uint8_t result[ADC_FRAME_SIZE] = {0};
+    uint32_t ret_num = 0;
+    float primary[MAX_PAIRS], reference[MAX_PAIRS], error[MAX_PAIRS];
+
+    dsp_arena_t arena;
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+#if LMS_USE_BLOCK
+    fblms_t *lms = fblms_create(&arena, LMS_TAPS, LMS_MU);
+#else
+    nlms_t *lms = nlms_create(&arena, LMS_TAPS, LMS_MU);
+#endif
+    dsp_arena_report(&arena, "filterLMS");
+    if (!lms)
+        return;
+
+    dac_init();
+    continuous_adc_init();
+
+    float ch6 = 0.0f;
+    int have_ch6 = 0;
+    int64_t last_report = esp_timer_get_time();
+
+    while (1)
+    {
+        if (flag)
+        {
+            flag = 0;
+            adc_continuous_read(ADC_handle, result, ADC_FRAME_SIZE, &ret_num, 0);
+
+            // 1️⃣ Separar los pares ch6 (primaria) / ch7 (referencia), centrados en 0
+            int pairs = 0;
+            for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t *p = (adc_digi_output_data_t *)&result[i];
+                float sample = (float)ADC_GET_DATA(p) / 4095.0f - 0.5f;
+
+                if (ADC_GET_CHANNEL(p) == ADC_CHANNEL_6) {
+                    ch6 = sample;
+                    have_ch6 = 1;
+                } else if (ADC_GET_CHANNEL(p) == ADC_CHANNEL_7 && have_ch6 && pairs < MAX_PAIRS) {
+                    primary[pairs] = ch6;
+                    reference[pairs] = sample;
+                    pairs++;
+                    have_ch6 = 0;
+                }
+            }
+
+            // 2️⃣ Filtrar y adaptar
+#if LMS_USE_BLOCK
+            fblms_process(lms, reference, primary, error, pairs);
+#else
+            nlms_process(lms, reference, primary, error, pairs);
+#endif
+
+            // 3️⃣ Saturar, escalar a 0-255 y escribir al DAC
+            for (int i = 0; i < pairs; i++) {
+                float out = error[i] + 0.5f;
+                if (out < 0.0f) out = 0.0f;
+                if (out > 1.0f) out = 1.0f;
+                dac_oneshot_output_voltage(DAC_handle, (uint8_t)(out * 255.0f));
+            }
+        }
+
+        // Métricas de convergencia
+        int64_t now = esp_timer_get_time();
+        if (now - last_report >= LMS_REPORT_US) {
+            last_report = now;
+            ESP_LOGI(TAG, "d^2 %.3e  e^2 %.3e  atenuación %.1f dB",
+                     lms->stats.desired_power, lms->stats.error_power,
+                     lms_stats_reduction_db(&lms->stats));
+        }
+    }
+
+    ESP_ERROR_CHECK(adc_continuous_stop(ADC_handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(ADC_handle));
+}
@@ -0,0 +1,294 @@
+// Comparación de los kernels en C (filterKernels.c) contra las plantillas de
+// filters.hpp para los órdenes chicos que se usan en filterFIR.c,
+// filterFIRQ15.c y filterIIR.c. Verifica que den el mismo resultado y mide
+// ns por muestra (mejor de REPEATS corridas). Las cascadas en Q15 y Q31 se
+// comparan contra la de float en C, con el error de cuantización como límite.
+// Termina con código 1 si alguna diferencia pasa su límite.
+//
+// En la placa: seleccionar filterTemplates.cpp en main/CMakeLists.txt.
+// En el host:
+//   gcc -O2 -c main/dspArena.c main/filterKernels.c -Imain
+//   g++ -O2 -std=c++17 -Imain main/filterTemplates.cpp dspArena.o filterKernels.o -o filterTemplates
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#else
+#include <time.h>
+#endif
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "filters.hpp"
+
+extern "C" {
+#include "dspArena.h"
+}
+
+#define N_SAMPLES   1024
+#define REPEATS     8
+
+// Cascadas en punto fijo contra float: redondeo de la salida de cada sección
+// y coeficientes en Q14 / Q30 (~4x sobre lo medido en el host)
+#define SOS_Q15_LIMIT   4e-4
+#define SOS_Q31_LIMIT   4e-7
+
+static uint8_t dsp_arena_buffer[4096] __attribute__((aligned(16)));
+static dsp_arena_t arena;
+
+static float input[N_SAMPLES];
+static int16_t input_q15[N_SAMPLES];
+static int32_t input_q31[N_SAMPLES];
+static float out_c[N_SAMPLES], out_t[N_SAMPLES];
+static int16_t out_c_q15[N_SAMPLES], out_t_q15[N_SAMPLES];
+static int32_t out_t_q31[N_SAMPLES];
+static int failures;
+
+static double now_ns(void)
+{
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time() * 1000.0;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+// -------------------- COEFICIENTES --------------------
+// Los de filterFIR.c (PROMEDIO, 3.1.1 orden 5, 3.1.2 orden 10) y un binomial de 8
+static constexpr std::array<float, 4> fir4 = {0.25f, 0.25f, 0.25f, 0.25f};
+static constexpr std::array<float, 6> fir6 = {0.0f, 0.0365241197f, 0.4634758802f, 0.4634758802f, 0.0365241197f, 0.0f};
+static constexpr std::array<float, 8> fir8 = {1 / 128.0f, 7 / 128.0f, 21 / 128.0f, 35 / 128.0f,
+                                              35 / 128.0f, 21 / 128.0f, 7 / 128.0f, 1 / 128.0f};
+static constexpr std::array<float, 11> fir11 = {0.0605303122f, 0.0f, -0.1008838537f, 0.0f, 0.3026516118f, 0.4754039606f,
+                                                0.3026516118f, 0.0f, -0.1008838537f, 0.0f, 0.0605303122f};
+
+// filterFIRQ15.c
+static constexpr std::array<int16_t, 6> fir6_q15 = {
+    dsp::q15(-0.0882352941), dsp::q15(0.1470588235), dsp::q15(0.4411764705),
+    dsp::q15(0.4411764705), dsp::q15(0.1470588235), dsp::q15(-0.0882352941)};
+
+// filterIIR.c
+#define NUM_SOS 3
+static const float sos_x[NUM_SOS * 3] = {1.0f, 2.0f, 1.0f,  1.0f, 2.0f, 1.0f,  1.0f, 1.0f, 0.0f};
+static const float sos_y[NUM_SOS * 3] = {1.0f, 0.0f, 0.5279f,  1.0f, 0.0f, 0.1056f,  1.0f, 0.0f, 0.0f};
+static const float sos_gain[NUM_SOS] = {0.3820f, 0.2764f, 0.5000f};
+static constexpr std::array<dsp::BiquadCoeffs<float>, NUM_SOS> sos = {
+    dsp::make_biquad<float>(1.0, 2.0, 1.0, 1.0, 0.0, 0.5279, 0.3820),
+    dsp::make_biquad<float>(1.0, 2.0, 1.0, 1.0, 0.0, 0.1056, 0.2764),
+    dsp::make_biquad<float>(1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.5000)};
+
+// La misma cascada en punto fijo (Q14 / Q30, ganancia plegada en b)
+template <typename T>
+static constexpr std::array<dsp::BiquadCoeffs<T>, NUM_SOS> sos_fixed = {
+    dsp::make_biquad<T>(1.0, 2.0, 1.0, 1.0, 0.0, 0.5279, 0.3820),
+    dsp::make_biquad<T>(1.0, 2.0, 1.0, 1.0, 0.0, 0.1056, 0.2764),
+    dsp::make_biquad<T>(1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.5000)};
+// -------------------- COEFICIENTES --------------------
+
+// limit: diferencia máxima admitida contra C (0 = tiene que ser idéntico)
+static void report(const char *name, double ns_c, double ns_t, double ns_k, double max_diff,
+                   double limit)
+{
+    int ok = max_diff <= limit;
+    printf("%-10s %10.1f %10.1f %10.1f %8.2fx %8.2fx %10.2e %9.1e  %s\n", name, ns_c, ns_t, ns_k,
+           ns_c / ns_t, ns_c / ns_k, max_diff, limit, ok ? "OK" : "FALLA");
+    if (!ok)
+        failures++;
+}
+
+template <typename F> static double best_ns(F &&run)
+{
+    double best = 1e30;
+    for (int rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns();
+        run();
+        best = fmin(best, now_ns() - t0);
+    }
+    return best / N_SAMPLES;
+}
+
+static double max_diff(const float *a, const float *b)
+{
+    double d = 0.0;
+    for (int i = 0; i < N_SAMPLES; i++)
+        d = fmax(d, fabs((double)a[i] - b[i]));
+    return d;
+}
+
+// C vs Fir<N> (coeficientes en el objeto) vs Fir<N, float, &C> (constexpr)
+template <int N, const std::array<float, N> *C>
+static void bench_fir(const char *name)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    fir_state_t *fir = fir_create(&arena, C->data(), N);
+
+    double ns_c = best_ns([&] {
+        fir_reset(fir);
+        for (int i = 0; i < N_SAMPLES; i++)
+            out_c[i] = fir_filter(fir, input[i]);
+    });
+
+    dsp::Fir<N> fir_t(*fir);
+    double ns_t = best_ns([&] {
+        fir_t.reset();
+        fir_t.process(input, out_t, N_SAMPLES);
+    });
+    double diff = max_diff(out_c, out_t);
+
+    dsp::Fir<N, float, C> fir_k;
+    double ns_k = best_ns([&] {
+        fir_k.reset();
+        fir_k.process(input, out_t, N_SAMPLES);
+    });
+    diff = fmax(diff, max_diff(out_c, out_t));
+
+    report(name, ns_c, ns_t, ns_k, diff, 0.0);
+    dsp_arena_rollback(&arena, mark);
+}
+
+static void bench_fir_q15(void)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    fir_q15_state_t *fir = fir_q15_create(&arena, fir6_q15.data(), 6);
+
+    double ns_c = best_ns([&] {
+        fir_q15_reset(fir);
+        for (int i = 0; i < N_SAMPLES; i++)
+            out_c_q15[i] = fir_filter_q15(fir, input_q15[i]);
+    });
+
+    dsp::Fir<6, int16_t> fir_t(*fir);
+    double ns_t = best_ns([&] {
+        fir_t.reset();
+        fir_t.process(input_q15, out_t_q15, N_SAMPLES);
+    });
+    int diff = 0;
+    for (int i = 0; i < N_SAMPLES; i++)
+        diff = diff > abs(out_c_q15[i] - out_t_q15[i]) ? diff : abs(out_c_q15[i] - out_t_q15[i]);
+
+    dsp::Fir<6, int16_t, &fir6_q15> fir_k;
+    double ns_k = best_ns([&] {
+        fir_k.reset();
+        fir_k.process(input_q15, out_t_q15, N_SAMPLES);
+    });
+    for (int i = 0; i < N_SAMPLES; i++)
+        diff = diff > abs(out_c_q15[i] - out_t_q15[i]) ? diff : abs(out_c_q15[i] - out_t_q15[i]);
+
+    report("fir6_q15", ns_c, ns_t, ns_k, diff, 0.0);
+    dsp_arena_rollback(&arena, mark);
+}
+
+static void bench_sos(void)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    iir_sos_state_t *iir = iir_sos_create(&arena, sos_x, sos_y, sos_gain, NUM_SOS);
+
+    double ns_c = best_ns([&] {
+        iir_sos_reset(iir);
+        for (int i = 0; i < N_SAMPLES; i++)
+            out_c[i] = iir_sos_filter(iir, input[i]);
+    });
+
+    dsp::BiquadCascade<NUM_SOS> sos_t(*iir);
+    double ns_t = best_ns([&] {
+        sos_t.reset();
+        sos_t.process(input, out_t, N_SAMPLES);
+    });
+    double diff = max_diff(out_c, out_t);
+
+    dsp::BiquadCascade<NUM_SOS, float, &sos> sos_k;
+    double ns_k = best_ns([&] {
+        sos_k.reset();
+        sos_k.process(input, out_t, N_SAMPLES);
+    });
+    diff = fmax(diff, max_diff(out_c, out_t));
+
+    report("sos3", ns_c, ns_t, ns_k, diff, 0.0);
+    dsp_arena_rollback(&arena, mark);
+}
+
+// BiquadCascade<3, int16_t / int32_t> contra iir_sos_filter en float. C es la
+// cascada de float; la diferencia está en unidades de media escala.
+template <typename T>
+static void bench_sos_fixed(const char *name, const T *in, T *out, double full_scale, double limit)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(&arena);
+    iir_sos_state_t *iir = iir_sos_create(&arena, sos_x, sos_y, sos_gain, NUM_SOS);
+    if (!iir) {
+        printf("%-10s sin memoria en la arena\n", name);
+        failures++;
+        return;
+    }
+
+    double ns_c = best_ns([&] {
+        iir_sos_reset(iir);
+        for (int i = 0; i < N_SAMPLES; i++)
+            out_c[i] = iir_sos_filter(iir, (float)(in[i] / full_scale));
+    });
+
+    auto diff_from_c = [&] {
+        double d = 0.0;
+        for (int i = 0; i < N_SAMPLES; i++)
+            d = fmax(d, fabs(out[i] / full_scale - out_c[i]));
+        return d;
+    };
+
+    // Coeficientes convertidos desde el struct de C
+    dsp::BiquadCascade<NUM_SOS, T> sos_t(*iir);
+    double ns_t = best_ns([&] {
+        sos_t.reset();
+        sos_t.process(in, out, N_SAMPLES);
+    });
+    double diff = diff_from_c();
+
+    dsp::BiquadCascade<NUM_SOS, T, &sos_fixed<T>> sos_k;
+    double ns_k = best_ns([&] {
+        sos_k.reset();
+        sos_k.process(in, out, N_SAMPLES);
+    });
+    diff = fmax(diff, diff_from_c());
+
+    report(name, ns_c, ns_t, ns_k, diff, limit);
+    dsp_arena_rollback(&arena, mark);
+}
+
+static int run_bench(void)
+{
+    dsp_arena_init(&arena, dsp_arena_buffer, sizeof(dsp_arena_buffer));
+
+    uint32_t seed = 12345;
+    for (int n = 0; n < N_SAMPLES; n++) {
+        seed = seed * 1664525u + 1013904223u;
+        input[n] = 0.5f * (float)sin(0.3 * n) + (float)((seed >> 8) / 16777216.0 - 0.5) * 0.2f;
+        input_q15[n] = (int16_t)lrintf(input[n] * 32767.0f);
+        input_q31[n] = (int32_t)lrint(input[n] * 2147483647.0);
+    }
+
+    printf("ns por muestra (C = filterKernels.c, T = plantilla, K = plantilla constexpr)\n");
+    printf("%-10s %10s %10s %10s %9s %9s %10s %9s\n", "filtro", "C", "T", "K", "C/T", "C/K", "dif max",
+           "limite");
+    bench_fir<4, &fir4>("fir4");
+    bench_fir<6, &fir6>("fir6");
+    bench_fir<8, &fir8>("fir8");
+    bench_fir<11, &fir11>("fir11");
+    bench_fir_q15();
+    bench_sos();
+    bench_sos_fixed<int16_t>("sos3_q15", input_q15, out_t_q15, 32767.0, SOS_Q15_LIMIT);
+    bench_sos_fixed<int32_t>("sos3_q31", input_q31, out_t_q31, 2147483647.0, SOS_Q31_LIMIT);
+    dsp_arena_report(&arena, "filterTemplates");
+    return failures;
+}
+
+#ifdef ESP_PLATFORM
+extern "C" void app_main(void)
+{
+    run_bench();
+}
+#else
+int main(void)
+{
+    return run_bench() ? 1 : 0;
+}
+#endif
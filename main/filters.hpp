@@ -0,0 +1,356 @@
+#ifndef FILTERS_HPP
+#define FILTERS_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+#include "filterKernels.h"
+}
+
+// -------------------- FILTROS CON PLANTILLAS --------------------
+// Versión C++ (sólo header) de fir_filter e iir_sos_filter con el orden y el
+// tipo de muestra como parámetros de plantilla: los lazos se desenrollan en
+// tiempo de compilación (index_sequence), el estado vive en un std::array que
+// el compilador puede mantener en registros dentro de process(bloque), y con
+// coeficientes constexpr las multiplicaciones se pliegan a constantes.
+//
+// Tipos de muestra:
+//  - float
+//  - int16_t (Q15): coeficientes FIR en Q15, acumulador de 32 bits, saturación
+//  - int32_t (Q31): coeficientes FIR en Q31, acumulador de 64 bits, saturación
+// Los coeficientes de los biquads pueden valer hasta 2 (a1), así que en punto
+// fijo van con un bit entero más: Q14 para int16_t y Q30 para int32_t, y el
+// acumulador es de 64 bits (5 productos de Q15 x Q14 no entran en 32).
+//
+// Interoperan con filterKernels.h: se construyen desde un fir_state_t /
+// fir_q15_state_t / iir_sos_state_t (copiando coeficientes y estado) y
+// save_state() devuelve el estado al struct de C. Si el order / num_sos del
+// struct no coincide con el de la plantilla se copia sólo la parte común
+// (nunca se lee ni escribe fuera de sus buffers), valid() da false y en
+// debug salta el assert.
+
+namespace dsp {
+
+// -------------------- TIPOS DE MUESTRA --------------------
+template <typename T> struct SampleTraits;
+
+template <> struct SampleTraits<float> {
+    using acc_t = float;
+    using sos_acc_t = float;
+    static constexpr int fir_frac = 0;
+    static constexpr int sos_frac = 0;
+    static constexpr float from_acc(float acc, int) { return acc; }
+};
+
+template <> struct SampleTraits<int16_t> {
+    using acc_t = int32_t;
+    using sos_acc_t = int64_t;
+    static constexpr int fir_frac = 15;
+    static constexpr int sos_frac = 14;
+    template <typename A> static constexpr int16_t from_acc(A acc, int frac)
+    {
+        acc >>= frac;
+        return acc > 32767 ? 32767 : acc < -32768 ? -32768 : (int16_t)acc;
+    }
+};
+
+template <> struct SampleTraits<int32_t> {
+    using acc_t = int64_t;
+    using sos_acc_t = int64_t;
+    static constexpr int fir_frac = 31;
+    static constexpr int sos_frac = 30;
+    template <typename A> static constexpr int32_t from_acc(A acc, int frac)
+    {
+        acc >>= frac;
+        return acc > INT32_MAX ? INT32_MAX : acc < INT32_MIN ? INT32_MIN : (int32_t)acc;
+    }
+};
+
+// Conversión de coeficientes en tiempo de compilación (redondeo y saturación)
+constexpr int16_t q15(double v, int frac = 15)
+{
+    double s = v * (double)(1 << frac);
+    s += (s >= 0) ? 0.5 : -0.5;
+    return s >= 32767.0 ? 32767 : s <= -32768.0 ? -32768 : (int16_t)s;
+}
+
+constexpr int32_t q31(double v, int frac = 31)
+{
+    double s = v * (double)(1LL << frac);
+    s += (s >= 0) ? 0.5 : -0.5;
+    return s >= 2147483647.0 ? INT32_MAX : s <= -2147483648.0 ? INT32_MIN : (int32_t)s;
+}
+
+// -------------------- FIR --------------------
+// Fir<N, T>: coeficientes en tiempo de ejecución (copiados al objeto).
+// Fir<N, T, &coeffs>: coeficientes de un array constexpr global, plegados.
+template <int N, typename T = float, const std::array<T, N> *Coeffs = nullptr>
+class Fir {
+    static_assert(N >= 1, "el FIR necesita al menos un coeficiente");
+    using traits = SampleTraits<T>;
+    using acc_t = typename traits::acc_t;
+
+public:
+    constexpr Fir() : coeffs_{}, buffer_{}
+    {
+        if constexpr (Coeffs != nullptr)
+            coeffs_ = *Coeffs;
+    }
+
+    constexpr explicit Fir(const std::array<T, N> &coeffs) : coeffs_(coeffs), buffer_{}
+    {
+        static_assert(Coeffs == nullptr, "los coeficientes ya son constexpr");
+    }
+
+    explicit Fir(const T *coeffs) : Fir(coeffs, N)
+    {
+    }
+
+    // Desde el struct de filterKernels (el orden tiene que coincidir con N)
+    explicit Fir(const fir_state_t &state) : Fir(state.coeffs, state.order)
+    {
+        static_assert(std::is_same_v<T, float>, "fir_state_t es de float");
+        load_buffer(state.buffer, state.order);
+    }
+    explicit Fir(const fir_q15_state_t &state) : Fir(state.coeffs, state.order)
+    {
+        static_assert(std::is_same_v<T, int16_t>, "fir_q15_state_t es Q15");
+        load_buffer(state.buffer, state.order);
+    }
+
+    void save_state(fir_state_t &state) const
+    {
+        static_assert(std::is_same_v<T, float>, "fir_state_t es de float");
+        store_buffer(state.buffer, state.order);
+    }
+    void save_state(fir_q15_state_t &state) const
+    {
+        static_assert(std::is_same_v<T, int16_t>, "fir_q15_state_t es Q15");
+        store_buffer(state.buffer, state.order);
+    }
+
+    // false si se construyó desde un struct de C con otro orden
+    bool valid() const { return valid_; }
+
+    void reset() { buffer_ = {}; }
+
+    // Una muestra (mismo resultado que fir_filter / fir_filter_q15)
+    inline T process(T x)
+    {
+        return step(buffer_, x, std::make_index_sequence<N>{});
+    }
+
+    // Bloque: el estado se copia a una variable local para que quede en registros
+    void process(const T *in, T *out, int n)
+    {
+        std::array<T, N> buf = buffer_;
+        for (int i = 0; i < n; i++)
+            out[i] = step(buf, in[i], std::make_index_sequence<N>{});
+        buffer_ = buf;
+    }
+
+    static constexpr int order() { return N; }
+
+private:
+    template <size_t I> constexpr T coeff() const
+    {
+        if constexpr (Coeffs != nullptr)
+            return (*Coeffs)[I];
+        else
+            return coeffs_[I];
+    }
+
+    template <size_t J> static inline void shift(std::array<T, N> &buf, T x)
+    {
+        if constexpr (J == 0)
+            buf[0] = x;
+        else
+            buf[J] = buf[J - 1];
+    }
+
+    template <size_t... I>
+    inline T step(std::array<T, N> &buf, T x, std::index_sequence<I...>) const
+    {
+        // buf[0] la más nueva, igual que fir_buffer en filterFIR.c
+        (shift<N - 1 - I>(buf, x), ...);
+        // Suma de izquierda a derecha, en el mismo orden que fir_filter
+        acc_t acc = (... + ((acc_t)coeff<I>() * (acc_t)buf[I]));
+        return traits::from_acc(acc, traits::fir_frac);
+    }
+
+    // Los coeficientes que faltan quedan en cero
+    Fir(const T *coeffs, int order) : coeffs_{}, buffer_{}, valid_(order == N)
+    {
+        static_assert(Coeffs == nullptr, "los coeficientes ya son constexpr");
+        assert(order == N);
+        for (int i = 0; i < N && i < order; i++)
+            coeffs_[i] = coeffs[i];
+    }
+
+    template <typename S> void load_buffer(const S *src, int order)
+    {
+        for (int i = 0; i < N && i < order; i++)
+            buffer_[i] = src[i];
+    }
+    template <typename S> void store_buffer(S *dst, int order) const
+    {
+        for (int i = 0; i < N && i < order; i++)
+            dst[i] = buffer_[i];
+    }
+
+    std::array<T, N> coeffs_;
+    std::array<T, N> buffer_;
+    bool valid_ = true;
+};
+
+// -------------------- CASCADA DE BIQUADS --------------------
+// Forma directa I por sección, como iir_sos_filter: a0 normalizado a 1 y la
+// ganancia de cada sección aplicada a su salida (el estado guarda y antes de
+// la ganancia, así el estado es intercambiable con iir_sos_state_t).
+// En punto fijo la ganancia se pliega en b0..b2: la y sin ganancia puede
+// pasar de 1 y saturaría.
+template <typename T> struct BiquadCoeffs {
+    T b0, b1, b2, a1, a2, gain;
+};
+
+// Coeficientes normalizados desde {b0,b1,b2} {a0,a1,a2} y ganancia
+template <typename T>
+constexpr BiquadCoeffs<T> make_biquad(double b0, double b1, double b2,
+                                      double a0, double a1, double a2, double gain)
+{
+    if constexpr (SampleTraits<T>::sos_frac == 0) {
+        return {T(b0 / a0), T(b1 / a0), T(b2 / a0), T(a1 / a0), T(a2 / a0), T(gain)};
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        constexpr int f = SampleTraits<T>::sos_frac;
+        return {q15(b0 * gain / a0, f), q15(b1 * gain / a0, f), q15(b2 * gain / a0, f),
+                q15(a1 / a0, f), q15(a2 / a0, f), q15(1.0, f)};
+    } else {
+        constexpr int f = SampleTraits<T>::sos_frac;
+        return {q31(b0 * gain / a0, f), q31(b1 * gain / a0, f), q31(b2 * gain / a0, f),
+                q31(a1 / a0, f), q31(a2 / a0, f), q31(1.0, f)};
+    }
+}
+
+template <int S, typename T = float, const std::array<BiquadCoeffs<T>, S> *Coeffs = nullptr>
+class BiquadCascade {
+    static_assert(S >= 1, "la cascada necesita al menos una sección");
+    using traits = SampleTraits<T>;
+    using acc_t = typename traits::sos_acc_t;
+
+    struct State {
+        T x1, x2, y1, y2;
+    };
+
+public:
+    constexpr BiquadCascade() : coeffs_{}, state_{}
+    {
+        if constexpr (Coeffs != nullptr)
+            coeffs_ = *Coeffs;
+    }
+
+    constexpr explicit BiquadCascade(const std::array<BiquadCoeffs<T>, S> &coeffs)
+        : coeffs_(coeffs), state_{}
+    {
+        static_assert(Coeffs == nullptr, "los coeficientes ya son constexpr");
+    }
+
+    // Desde el struct de filterKernels (num_sos tiene que coincidir con S;
+    // si sobran secciones en la plantilla quedan como identidad)
+    explicit BiquadCascade(const iir_sos_state_t &sos) : state_{}, valid_(sos.num_sos == S)
+    {
+        static_assert(Coeffs == nullptr, "los coeficientes ya son constexpr");
+        assert(sos.num_sos == S);
+        int common = sos.num_sos < S ? sos.num_sos : S;
+        for (int s = 0; s < S; s++) {
+            if (s >= common) {
+                coeffs_[s] = make_biquad<T>(1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0);
+                continue;
+            }
+            const float *b = &sos.coeffs_x[3 * s];
+            const float *a = &sos.coeffs_y[3 * s];
+            coeffs_[s] = make_biquad<T>(b[0], b[1], b[2], a[0], a[1], a[2], sos.gain[s]);
+        }
+        if constexpr (traits::sos_frac == 0) {
+            for (int s = 0; s < common; s++)
+                state_[s] = {sos.x_buffer[2 * s], sos.x_buffer[2 * s + 1],
+                             sos.y_buffer[2 * s], sos.y_buffer[2 * s + 1]};
+        }
+    }
+
+    // El estado sólo se comparte en float (iir_sos_state_t es de float)
+    void save_state(iir_sos_state_t &sos) const
+    {
+        static_assert(traits::sos_frac == 0, "iir_sos_state_t es de float");
+        for (int s = 0; s < S && s < sos.num_sos; s++) {
+            sos.x_buffer[2 * s] = state_[s].x1;
+            sos.x_buffer[2 * s + 1] = state_[s].x2;
+            sos.y_buffer[2 * s] = state_[s].y1;
+            sos.y_buffer[2 * s + 1] = state_[s].y2;
+        }
+    }
+
+    // false si se construyó desde un iir_sos_state_t con otro num_sos
+    bool valid() const { return valid_; }
+
+    void reset() { state_ = {}; }
+
+    inline T process(T x)
+    {
+        return run(state_, x, std::make_index_sequence<S>{});
+    }
+
+    void process(const T *in, T *out, int n)
+    {
+        std::array<State, S> st = state_;
+        for (int i = 0; i < n; i++)
+            out[i] = run(st, in[i], std::make_index_sequence<S>{});
+        state_ = st;
+    }
+
+    static constexpr int sections() { return S; }
+
+private:
+    template <size_t I> constexpr const BiquadCoeffs<T> &coeff() const
+    {
+        if constexpr (Coeffs != nullptr)
+            return (*Coeffs)[I];
+        else
+            return coeffs_[I];
+    }
+
+    template <size_t I> static inline T section(State &st, const BiquadCoeffs<T> &c, T x)
+    {
+        constexpr int f = traits::sos_frac;
+        acc_t acc = (acc_t)c.b0 * x + (acc_t)c.b1 * st.x1 + (acc_t)c.b2 * st.x2
+                  - (acc_t)c.a1 * st.y1 - (acc_t)c.a2 * st.y2;
+        T y = traits::from_acc(acc, f);
+        st.x2 = st.x1;
+        st.x1 = x;
+        st.y2 = st.y1;
+        st.y1 = y;
+        if constexpr (f == 0)
+            return y * c.gain;
+        else
+            return y;
+    }
+
+    template <size_t... I>
+    inline T run(std::array<State, S> &st, T x, std::index_sequence<I...>) const
+    {
+        ((x = section<I>(st[I], coeff<I>(), x)), ...);
+        return x;
+    }
+
+    std::array<BiquadCoeffs<T>, S> coeffs_;
+    std::array<State, S> state_;
+    bool valid_ = true;
+};
+
+} // namespace dsp
+
+#endif
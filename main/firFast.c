@@ -0,0 +1,200 @@
+#include <string.h>
+#include "firFast.h"
+
+// -------------------- FIR DIRECTA --------------------
+void fir_direct_init(fir_direct_t *fir, const float *coeffs, int num_taps, float *delay)
+{
+    fir->coeffs = coeffs;
+    fir->num_taps = num_taps;
+    fir->delay = delay;
+    fir_direct_reset(fir);
+}
+
+void fir_direct_reset(fir_direct_t *fir)
+{
+    fir->pos = 0;
+    memset(fir->delay, 0, 2 * fir->num_taps * sizeof(float));
+}
+
+float fir_direct_sample(fir_direct_t *fir, float new_sample)
+{
+    int taps = fir->num_taps;
+
+    // La más nueva queda en pos (el índice baja en cada muestra)
+    fir->pos = (fir->pos == 0) ? taps - 1 : fir->pos - 1;
+    fir->delay[fir->pos] = new_sample;
+    fir->delay[fir->pos + taps] = new_sample;
+
+    // Convolución sobre la ventana contigua
+    const float *x = &fir->delay[fir->pos];
+    float result = 0.0f;
+    for (int i = 0; i < taps; i++)
+        result += fir->coeffs[i] * x[i];
+
+    return result;
+}
+
+void fir_direct_process(fir_direct_t *fir, const float *in, float *out, int n)
+{
+    for (int i = 0; i < n; i++)
+        out[i] = fir_direct_sample(fir, in[i]);
+}
+// -------------------- FIR DIRECTA --------------------
+
+// -------------------- FIR POR FFT (OVERLAP-SAVE) --------------------
+static int resolve_block(int num_taps, int block_size)
+{
+    if (block_size > 0)
+        return block_size;
+    int b = 2;
+    while (b < num_taps)
+        b *= 2;
+    return b;
+}
+
+size_t fir_fast_workspace_size(int num_taps, int block_size, int crossover_taps)
+{
+    if (num_taps < crossover_taps)
+        return 2 * (size_t)num_taps;
+
+    size_t B = resolve_block(num_taps, block_size);
+    size_t P = (num_taps + B - 1) / B;
+    return FFT_PLAN_TWIDDLE_SIZE(B) + 2 * P * (2 * B) + 2 * (2 * B) + 2 * B;
+}
+
+// acc += X * H para espectros empaquetados (DC y Nyquist son reales)
+static void spectrum_mac(float *acc, const float *x, const float *h, int B)
+{
+    acc[0] += x[0] * h[0];
+    acc[1] += x[1] * h[1];
+    for (int k = 1; k < B; k++) {
+        float xr = x[2 * k], xi = x[2 * k + 1];
+        float hr = h[2 * k], hi = h[2 * k + 1];
+        acc[2 * k]     += xr * hr - xi * hi;
+        acc[2 * k + 1] += xr * hi + xi * hr;
+    }
+}
+
+int fir_fast_init(fir_fast_t *fir, const float *coeffs, int num_taps,
+                  int block_size, int crossover_taps, float *workspace)
+{
+    if (num_taps < 1 || (block_size != 0 && (block_size < 2 || (block_size & (block_size - 1)))))
+        return -1;
+
+    memset(fir, 0, sizeof(*fir));
+    fir->num_taps = num_taps;
+
+    if (num_taps < crossover_taps) {
+        fir_direct_init(&fir->direct, coeffs, num_taps, workspace);
+        return 0;
+    }
+
+    int B = resolve_block(num_taps, block_size);
+    int P = (num_taps + B - 1) / B;
+
+    fir->use_fft = 1;
+    fir->block = B;
+    fir->partitions = P;
+
+    float *w = workspace;
+    if (fft_plan_init(&fir->plan, B, w) != 0)
+        return -1;
+    w += FFT_PLAN_TWIDDLE_SIZE(B);
+    fir->h = w;         w += P * 2 * B;
+    fir->fdl = w;       w += P * 2 * B;
+    fir->time = w;      w += 2 * B;
+    fir->acc = w;       w += 2 * B;
+    fir->in_fifo = w;   w += B;
+    fir->out_fifo = w;
+
+    // Espectro de cada partición: h[p*B .. p*B+B-1] con ceros hasta 2B
+    for (int p = 0; p < P; p++) {
+        float *hp = &fir->h[p * 2 * B];
+        memset(hp, 0, 2 * B * sizeof(float));
+        for (int i = 0; i < B && p * B + i < num_taps; i++)
+            hp[i] = coeffs[p * B + i];
+        fft_plan_forward_real(&fir->plan, hp);
+    }
+
+    fir_fast_reset(fir);
+    return 0;
+}
+
+fir_fast_t *fir_fast_create(dsp_arena_t *arena, const float *coeffs, int num_taps,
+                            int block_size, int crossover_taps)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    fir_fast_t *fir = dsp_arena_alloc(arena, sizeof(*fir), 0, "fir_fast");
+    float *workspace = dsp_arena_alloc_floats(arena,
+        fir_fast_workspace_size(num_taps, block_size, crossover_taps), "fir_fast");
+    if (!fir || !workspace ||
+        fir_fast_init(fir, coeffs, num_taps, block_size, crossover_taps, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return fir;
+}
+
+void fir_fast_reset(fir_fast_t *fir)
+{
+    if (!fir->use_fft) {
+        fir_direct_reset(&fir->direct);
+        return;
+    }
+    int B = fir->block;
+    fir->fill = 0;
+    fir->slot = 0;
+    memset(fir->fdl, 0, fir->partitions * 2 * B * sizeof(float));
+    memset(fir->time, 0, 2 * B * sizeof(float));
+    memset(fir->out_fifo, 0, B * sizeof(float));
+}
+
+int fir_fast_latency(const fir_fast_t *fir)
+{
+    return fir->use_fft ? fir->block : 0;
+}
+
+static void process_block(fir_fast_t *fir)
+{
+    int B = fir->block;
+    int P = fir->partitions;
+
+    // Ventana de 2B: bloque anterior + bloque nuevo
+    memmove(fir->time, fir->time + B, B * sizeof(float));
+    memcpy(fir->time + B, fir->in_fifo, B * sizeof(float));
+
+    fir->slot = (fir->slot + 1) % P;
+    float *x = &fir->fdl[fir->slot * 2 * B];
+    memcpy(x, fir->time, 2 * B * sizeof(float));
+    fft_plan_forward_real(&fir->plan, x);
+
+    // Y = sum_p X[bloque - p] * H[p]
+    memset(fir->acc, 0, 2 * B * sizeof(float));
+    for (int p = 0, s = fir->slot; p < P; p++) {
+        spectrum_mac(fir->acc, &fir->fdl[s * 2 * B], &fir->h[p * 2 * B], B);
+        s = (s == 0) ? P - 1 : s - 1;
+    }
+
+    fft_plan_inverse_real(&fir->plan, fir->acc);
+
+    // Sólo la segunda mitad es convolución lineal válida
+    memcpy(fir->out_fifo, fir->acc + B, B * sizeof(float));
+}
+
+void fir_fast_process(fir_fast_t *fir, const float *in, float *out, int n)
+{
+    if (!fir->use_fft) {
+        fir_direct_process(&fir->direct, in, out, n);
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        fir->in_fifo[fir->fill] = in[i];
+        out[i] = fir->out_fifo[fir->fill];
+        if (++fir->fill == fir->block) {
+            process_block(fir);
+            fir->fill = 0;
+        }
+    }
+}
+// -------------------- FIR POR FFT (OVERLAP-SAVE) --------------------
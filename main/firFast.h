@@ -0,0 +1,70 @@
+#ifndef FIR_FAST_H
+#define FIR_FAST_H
+
+#include <stddef.h>
+#include "fftPlan.h"
+#include "dspArena.h"
+
+// -------------------- FIR DIRECTA --------------------
+// Línea de retardo circular duplicada: cada muestra se escribe en delay[pos] y
+// delay[pos + num_taps], así delay[pos .. pos+num_taps-1] siempre es contiguo
+// (delay[pos] la más nueva, igual que fir_buffer[0] en filterFIR.c) y el
+// producto punto no necesita módulo ni desplazar el buffer.
+typedef struct {
+    const float *coeffs;
+    int num_taps;
+    int pos;
+    float *delay;           // 2*num_taps floats
+} fir_direct_t;
+
+void fir_direct_init(fir_direct_t *fir, const float *coeffs, int num_taps, float *delay);
+void fir_direct_reset(fir_direct_t *fir);
+float fir_direct_sample(fir_direct_t *fir, float new_sample);
+void fir_direct_process(fir_direct_t *fir, const float *in, float *out, int n);
+
+// -------------------- FIR POR FFT (OVERLAP-SAVE) --------------------
+// Convolución rápida por bloques de B muestras con FFT real de 2B puntos.
+// Los coeficientes se parten en P = ceil(num_taps / B) particiones uniformes
+// (UPOLS): la latencia es de B muestras sin importar el largo del filtro.
+// Con block_size = 0 se usa una sola partición (B >= num_taps).
+//
+// Por debajo de crossover_taps se usa la forma directa (latencia 0).
+// FIR_FAST_CROSSOVER_TAPS es una estimación, no una medición: es el valor
+// que se usa si no se calibra. El cruce real depende de la CPU y de B;
+// calibrate_crossover en filterFIRFast.c lo mide en la placa.
+#define FIR_FAST_CROSSOVER_TAPS     48
+
+typedef struct {
+    int use_fft;
+    int num_taps;
+    fir_direct_t direct;
+
+    // Overlap-save
+    int block;              // B
+    int partitions;         // P
+    int fill;               // muestras en in_fifo
+    int slot;               // partición más nueva en fdl
+    fft_plan_t plan;        // n = B complejos -> FFT real de 2B
+    float *h;               // P espectros de 2B floats
+    float *fdl;             // línea de retardo en frecuencia, P espectros
+    float *time;            // últimas 2B muestras de entrada
+    float *acc;             // acumulador / salida de la IFFT
+    float *in_fifo;         // B
+    float *out_fifo;        // B
+} fir_fast_t;
+
+// floats de workspace que necesita fir_fast_init con esos parámetros
+size_t fir_fast_workspace_size(int num_taps, int block_size, int crossover_taps);
+
+// block_size: 0 o potencia de 2 >= 2. Devuelve 0 si OK, -1 si los parámetros no sirven.
+int fir_fast_init(fir_fast_t *fir, const float *coeffs, int num_taps,
+                  int block_size, int crossover_taps, float *workspace);
+// Objeto + workspace desde la arena. NULL si no alcanza.
+fir_fast_t *fir_fast_create(dsp_arena_t *arena, const float *coeffs, int num_taps,
+                            int block_size, int crossover_taps);
+void fir_fast_reset(fir_fast_t *fir);
+// Muestras de retardo que agrega el procesamiento por bloques (0 en forma directa)
+int fir_fast_latency(const fir_fast_t *fir);
+void fir_fast_process(fir_fast_t *fir, const float *in, float *out, int n);
+
+#endif
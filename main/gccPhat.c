@@ -0,0 +1,112 @@
+#include <string.h>
+#include <math.h>
+#include "gccPhat.h"
+
+size_t gcc_phat_workspace_size(int block_size)
+{
+    return FFT_PLAN_TWIDDLE_SIZE(block_size) + 2 * (2 * (size_t)block_size);
+}
+
+int gcc_phat_init(gcc_phat_t *g, int block_size, int max_lag, float *workspace)
+{
+    if (block_size < 2 || (block_size & (block_size - 1)) || max_lag < 0 || max_lag >= block_size)
+        return -1;
+
+    memset(g, 0, sizeof(*g));
+    g->block = block_size;
+    g->max_lag = max_lag;
+    g->eps = 1e-20f;
+
+    float *w = workspace;
+    if (fft_plan_init(&g->plan, block_size, w) != 0)
+        return -1;
+    w += FFT_PLAN_TWIDDLE_SIZE(block_size);
+    g->x = w;   w += 2 * block_size;
+    g->y = w;
+    return 0;
+}
+
+gcc_phat_t *gcc_phat_create(dsp_arena_t *arena, int block_size, int max_lag)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    gcc_phat_t *g = dsp_arena_alloc(arena, sizeof(*g), 0, "gcc_phat");
+    float *workspace = dsp_arena_alloc_floats(arena, gcc_phat_workspace_size(block_size), "gcc_phat");
+    if (!g || !workspace || gcc_phat_init(g, block_size, max_lag, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return g;
+}
+
+// Copia sin la media y completa con ceros hasta 2N
+static void load_block(float *dst, const float *src, int n)
+{
+    float mean = 0.0f;
+    for (int i = 0; i < n; i++)
+        mean += src[i];
+    mean /= n;
+    for (int i = 0; i < n; i++)
+        dst[i] = src[i] - mean;
+    memset(dst + n, 0, n * sizeof(float));
+}
+
+float gcc_phat_correlation(const gcc_phat_t *g, int lag)
+{
+    // r[m] para m >= 0 en y[m], m < 0 al final (vuelta de la IFFT de 2N)
+    return g->y[(lag >= 0) ? lag : 2 * g->block + lag];
+}
+
+void gcc_phat_estimate(gcc_phat_t *g, const float *x, const float *y, gcc_phat_result_t *result)
+{
+    int N = g->block;
+    float *X = g->x, *Y = g->y;
+
+    load_block(X, x, N);
+    load_block(Y, y, N);
+    fft_plan_forward_real(&g->plan, X);
+    fft_plan_forward_real(&g->plan, Y);
+
+    // R = Y conj(X) / |Y conj(X)|; DC y Nyquist son reales (sólo queda el signo)
+    for (int k = 0; k < 2; k++) {
+        float r = Y[k] * X[k];
+        Y[k] = (r > g->eps) ? 1.0f : (r < -g->eps) ? -1.0f : 0.0f;
+    }
+    for (int k = 1; k < N; k++) {
+        float xr = X[2 * k], xi = X[2 * k + 1];
+        float yr = Y[2 * k], yi = Y[2 * k + 1];
+        float rr = yr * xr + yi * xi;
+        float ri = yi * xr - yr * xi;
+        float mag2 = rr * rr + ri * ri;
+        float inv = (mag2 > g->eps * g->eps) ? 1.0f / sqrtf(mag2) : 0.0f;
+        Y[2 * k] = rr * inv;
+        Y[2 * k + 1] = ri * inv;
+    }
+    fft_plan_inverse_real(&g->plan, Y);
+
+    // Pico en [-max_lag, max_lag]
+    int best = 0;
+    float peak = gcc_phat_correlation(g, 0);
+    for (int lag = 1; lag <= g->max_lag; lag++) {
+        float pos = gcc_phat_correlation(g, lag);
+        float neg = gcc_phat_correlation(g, -lag);
+        if (pos > peak) { peak = pos; best = lag; }
+        if (neg > peak) { peak = neg; best = -lag; }
+    }
+
+    // Interpolación parabólica con los vecinos (dentro de la correlación de 2N)
+    float delta = 0.0f;
+    if (best > -(N - 1) && best < N - 1) {
+        float a = gcc_phat_correlation(g, best - 1);
+        float c = gcc_phat_correlation(g, best + 1);
+        float den = a - 2.0f * peak + c;
+        if (den < 0.0f) {
+            delta = 0.5f * (a - c) / den;
+            if (delta > 0.5f) delta = 0.5f;
+            if (delta < -0.5f) delta = -0.5f;
+        }
+    }
+
+    result->lag_index = best;
+    result->lag = best + delta;
+    result->confidence = (peak < 0.0f) ? 0.0f : (peak > 1.0f) ? 1.0f : peak;
+}
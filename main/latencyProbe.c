@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "latencyProbe.h"
+
+static void hist_reset(latency_hist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->min = UINT32_MAX;
+}
+
+// Bins logarítmicos: exactos hasta 3 ticks y después 4 por octava (ancho
+// de un cuarto del borde inferior), así una etapa de 0.1 us tiene la misma
+// resolución relativa que el total
+static int hist_bin(uint32_t ticks)
+{
+    if (ticks < 4)
+        return (int)ticks;
+    int octave = 31 - __builtin_clz(ticks);
+    return 4 * (octave - 1) + (int)((ticks >> (octave - 2)) & 3);
+}
+
+static uint64_t hist_bin_edge(int bin)
+{
+    if (bin < 4)
+        return (uint64_t)bin;
+    return (uint64_t)(4 + bin % 4) << (bin / 4 - 1);
+}
+
+static void hist_add(latency_hist_t *h, uint32_t ticks)
+{
+    h->bins[hist_bin(ticks)]++;
+    h->count++;
+    h->sum += ticks;
+    if (ticks < h->min) h->min = ticks;
+    if (ticks > h->max) h->max = ticks;
+}
+
+// Fracción q, interpolando dentro del bin donde se alcanza (entre mín y máx)
+static uint32_t hist_percentile(const latency_hist_t *h, float q)
+{
+    uint32_t target = (uint32_t)ceilf(q * h->count);
+    if (target == 0)
+        target = 1;
+    uint32_t acc = 0;
+    for (int i = 0; i < LATENCY_LOG_BINS; i++) {
+        if (acc + h->bins[i] >= target) {
+            double low = (double)hist_bin_edge(i);
+            double width = (double)hist_bin_edge(i + 1) - low;
+            double value = low + width * (target - acc) / h->bins[i];
+            if (value < h->min) return h->min;
+            if (value > h->max) return h->max;
+            return (uint32_t)value;
+        }
+        acc += h->bins[i];
+    }
+    return h->max;
+}
+
+static void total_add(latency_probe_t *p, uint32_t ticks)
+{
+    uint32_t bin = ticks / p->bin_width;
+    p->total_bins[bin < LATENCY_HIST_BINS ? bin : LATENCY_HIST_BINS - 1]++;
+    hist_add(&p->total, ticks);
+}
+
+void latency_probe_init(latency_probe_t *p, float block_period_us, float bin_us)
+{
+    memset(p, 0, sizeof(*p));
+    p->deadline = (uint32_t)lrintf(block_period_us * LATENCY_TICKS_PER_US);
+    p->bin_width = bin_us > 0.0f ? (uint32_t)lrintf(bin_us * LATENCY_TICKS_PER_US) : p->deadline / 16;
+    if (p->bin_width == 0)
+        p->bin_width = 1;
+    p->num_stages = 1;
+    p->stage_names[0] = "cola";
+    latency_probe_reset(p);
+}
+
+int latency_probe_add_stage(latency_probe_t *p, const char *name)
+{
+    if (p->num_stages == LATENCY_MAX_STAGES)
+        return -1;
+    p->stage_names[p->num_stages] = name;
+    hist_reset(&p->stages[p->num_stages]);
+    return p->num_stages++;
+}
+
+void latency_probe_set_impulse(latency_probe_t *p, int period_blocks, float level, float threshold)
+{
+    p->impulse_period = period_blocks > 0 ? period_blocks : 0;
+    p->impulse_timeout = period_blocks > 1 ? period_blocks - 1 : 1;
+    p->impulse_level = level;
+    p->impulse_threshold = threshold;
+    p->impulse_countdown = p->impulse_period;
+    p->impulse_pending = 0;
+}
+
+void latency_probe_reset(latency_probe_t *p)
+{
+    for (int i = 0; i < LATENCY_MAX_STAGES; i++)
+        hist_reset(&p->stages[i]);
+    hist_reset(&p->total);
+    memset(p->total_bins, 0, sizeof(p->total_bins));
+    hist_reset(&p->impulse);
+    p->blocks = 0;
+    p->deadline_misses = 0;
+    p->backlog_sum = 0;
+    p->backlog_max = 0;
+    p->lost_times = 0;
+    p->dropped_at_reset = atomic_load_explicit(&p->dropped, memory_order_relaxed);
+    p->impulses_lost = 0;
+    p->impulse_pending = 0;
+    p->discard = 1;
+}
+
+void latency_probe_begin(latency_probe_t *p)
+{
+    uint32_t now = latency_now();
+    // dropped antes que produced: todo perdido que se cuente ya está en produced
+    uint32_t dropped = atomic_load_explicit(&p->dropped, memory_order_acquire);
+    uint32_t produced = atomic_load_explicit(&p->produced, memory_order_acquire);
+    uint32_t seq = p->next_frame;
+    p->last_time = now;
+
+    // Los perdidos no están en el pool: el driver entrega el siguiente que entró
+    while (seq != produced && atomic_load_explicit(&p->isr_dropped[seq % LATENCY_RING], memory_order_relaxed)) {
+        seq++;
+        p->dropped_seen++;
+    }
+    p->recording = !p->discard && seq != produced;
+    p->discard = 0;
+    if (seq == produced) {
+        p->next_frame = seq;            // no hay marco que leer
+        return;
+    }
+    p->next_frame = seq + 1;
+
+    // Marcos en el pool contando el que se lee
+    int32_t dropped_ahead = (int32_t)(dropped - p->dropped_seen);
+    uint32_t backlog = produced - seq - (dropped_ahead > 0 ? (uint32_t)dropped_ahead : 0);
+
+    p->block_time = atomic_load_explicit(&p->isr_time[seq % LATENCY_RING], memory_order_relaxed);
+    // Si el callback ya dio la vuelta al anillo el instante es de otro marco
+    if (atomic_load_explicit(&p->produced, memory_order_acquire) - seq > LATENCY_RING) {
+        if (p->recording)
+            p->lost_times++;
+        p->recording = 0;
+        p->block_time = now;
+    }
+    if (p->recording) {
+        p->backlog_sum += backlog;
+        if (backlog > p->backlog_max)
+            p->backlog_max = backlog;
+        hist_add(&p->stages[0], now - p->block_time);
+    }
+}
+
+void latency_probe_stage(latency_probe_t *p, int stage)
+{
+    uint32_t now = latency_now();
+    if (p->recording && stage > 0 && stage < p->num_stages)
+        hist_add(&p->stages[stage], now - p->last_time);
+    p->last_time = now;
+}
+
+float latency_probe_inject(latency_probe_t *p, float x)
+{
+    if (!p->impulse_period || p->impulse_pending || --p->impulse_countdown > 0)
+        return x;
+    p->impulse_countdown = p->impulse_period;
+    p->impulse_pending = 1;
+    p->impulse_time = p->block_time - p->deadline;
+    return p->impulse_level;
+}
+
+void latency_probe_output(latency_probe_t *p, float y)
+{
+    if (p->impulse_pending && fabsf(y - p->last_output) > p->impulse_threshold) {
+        if (p->recording)
+            hist_add(&p->impulse, latency_now() - p->impulse_time);
+        p->impulse_pending = 0;
+    }
+    p->last_output = y;
+}
+
+void latency_probe_end(latency_probe_t *p)
+{
+    uint32_t now = latency_now();
+    if (p->recording) {
+        uint32_t total = now - p->block_time;
+        total_add(p, total);
+        p->blocks++;
+        if (total > p->deadline)
+            p->deadline_misses++;
+    }
+    if (p->impulse_pending && ++p->impulse_pending > p->impulse_timeout) {
+        p->impulses_lost++;
+        p->impulse_pending = 0;
+    }
+}
+
+static void print_row(const char *name, const latency_hist_t *h, double total_mean)
+{
+    if (!h->count)
+        return;
+    double us = 1.0 / LATENCY_TICKS_PER_US;
+    double mean = (double)h->sum / h->count;
+    printf("%-12s %9.2f %9.2f %9.2f %9.2f", name, mean * us, h->min * us,
+           hist_percentile(h, 0.99f) * us, h->max * us);
+    if (total_mean > 0.0)
+        printf(" %6.1f%%", 100.0 * mean / total_mean);
+    printf("\n");
+}
+
+void latency_probe_report(const latency_probe_t *p, const char *title)
+{
+    double us = 1.0 / LATENCY_TICKS_PER_US;
+    double total_mean = p->total.count ? (double)p->total.sum / p->total.count : 0.0;
+
+    printf("---- %s: latencia ADC->DAC (plazo %.2f us) ----\n", title, p->deadline * us);
+    printf("%-12s %9s %9s %9s %9s %7s\n", "etapa (us)", "media", "min", "p99", "max", "aporte");
+    for (int i = 0; i < p->num_stages; i++)
+        print_row(p->stage_names[i], &p->stages[i], total_mean);
+    print_row("total", &p->total, 0.0);
+    print_row("impulso", &p->impulse, 0.0);
+    printf("bloques %u, fuera de plazo %u (%.3f%%)", (unsigned)p->blocks, (unsigned)p->deadline_misses,
+           p->blocks ? 100.0 * p->deadline_misses / p->blocks : 0.0);
+    if (p->impulse_period)
+        printf(", impulsos %u (perdidos %u)", (unsigned)p->impulse.count, (unsigned)p->impulses_lost);
+    printf("\n");
+    uint32_t dropped = atomic_load_explicit(&p->dropped, memory_order_relaxed) - p->dropped_at_reset;
+    printf("cola: media %.1f, max %u marcos; perdidos con el pool lleno %u",
+           p->blocks ? (double)p->backlog_sum / p->blocks : 0.0, (unsigned)p->backlog_max, (unsigned)dropped);
+    if (p->lost_times)
+        printf("; %u bloques sin medir (cola > %d marcos)", (unsigned)p->lost_times, LATENCY_RING);
+    printf("\n");
+
+    // Histograma del total, sólo los bins con cuentas
+    uint32_t peak = 0;
+    for (int i = 0; i < LATENCY_HIST_BINS; i++)
+        peak = p->total_bins[i] > peak ? p->total_bins[i] : peak;
+    for (int i = 0; i < LATENCY_HIST_BINS && peak; i++) {
+        if (!p->total_bins[i])
+            continue;
+        char bar[33];
+        int len = (int)((uint64_t)p->total_bins[i] * 32 / peak);
+        memset(bar, '#', len);
+        bar[len] = '\0';
+        if (i < LATENCY_HIST_BINS - 1)
+            printf("%8.2f - %8.2f us %10u %s\n", i * p->bin_width * us, (i + 1) * p->bin_width * us,
+                   (unsigned)p->total_bins[i], bar);
+        else
+            printf("%8.2f -      ... us %10u %s\n", i * p->bin_width * us, (unsigned)p->total_bins[i], bar);
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#include "esp_cpu.h"
+#else
+#include <time.h>
+#endif
+
+// -------------------- SONDA DE LATENCIA --------------------
+// Mide la latencia ADC→DAC bloque a bloque, incluyendo el buffer del driver,
+// adc_continuous_read, el procesamiento y la escritura al DAC:
+//  - el callback del ADC marca la llegada del marco (latency_probe_isr),
+//  - el lazo principal toma el bloque (latency_probe_begin), marca el fin de
+//    cada etapa (latency_probe_stage) y cierra al entregar al DAC
+//    (latency_probe_end).
+// La etapa 0 es siempre "cola": del callback hasta que el lazo toma el bloque.
+// Se acumula un histograma por etapa y otro del total, y se cuentan los
+// bloques que terminan después del plazo (el período de un bloque: si el
+// total lo supera, el marco siguiente ya llegó).
+//
+// El callback numera los marcos y guarda el instante de cada uno en un anillo
+// de LATENCY_RING entradas. Cada latency_probe_begin consume un marco, el más
+// viejo que entró al pool (es el que entrega adc_continuous_read), así que la
+// cola y el total se miden contra la llegada del marco que realmente se leyó,
+// aunque haya otros esperando detrás. Se reportan la profundidad de esa cola
+// y los marcos que el driver perdió con el pool lleno (latency_probe_isr_dropped
+// desde on_pool_ovf).
+//
+// Opcionalmente reemplaza la primera muestra de cada impulse_period bloques
+// por un impulso y mide cuándo aparece en la salida; eso suma el retardo del
+// propio filtro y el tiempo de adquisición del marco (se toma que la primera
+// muestra se convirtió un período de bloque antes del callback). Para que la
+// detección no dé falsos positivos la entrada tiene que estar quieta.
+//
+// Tiempos en ticks de 32 bits (ciclos de CPU en la placa, ns en el host); las
+// restas son módulo 2^32 (intervalos de hasta ~26 s a 160 MHz). El contador
+// de ciclos es por núcleo: el callback y el lazo tienen que correr en el
+// mismo (app_main y el ISR del ADC quedan los dos en el núcleo 0).
+
+#define LATENCY_MAX_STAGES      6
+#define LATENCY_HIST_BINS       32      // histograma impreso del total; el último junta el resto
+#define LATENCY_LOG_BINS        124     // exactos hasta 3 ticks y 4 por octava hasta 2^32
+#define LATENCY_RING            512     // potencia de 2; el doble del pool de filterFIR (256 marcos)
+
+#ifdef ESP_PLATFORM
+#define LATENCY_TICKS_PER_US    CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+static inline uint32_t latency_now(void)
+{
+    return (uint32_t)esp_cpu_get_cycle_count();
+}
+#else
+#define LATENCY_TICKS_PER_US    1000
+static inline uint32_t latency_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min, max;                  // ticks
+    uint64_t sum;
+    uint32_t bins[LATENCY_LOG_BINS];    // escala logarítmica: el p99 sirve igual para 0.1 us que para 50 us
+} latency_hist_t;
+
+typedef struct {
+    uint32_t deadline;                  // ticks (período de un bloque)
+    uint32_t bin_width;                 // ticks, del histograma impreso del total
+    int num_stages;
+    const char *stage_names[LATENCY_MAX_STAGES];
+    latency_hist_t stages[LATENCY_MAX_STAGES];
+    latency_hist_t total;
+    uint32_t total_bins[LATENCY_HIST_BINS];
+
+    // Los escribe el callback del ADC; las entradas del anillo van por número
+    // de secuencia del marco (módulo LATENCY_RING)
+    atomic_uint_least32_t isr_time[LATENCY_RING];
+    atomic_uchar isr_dropped[LATENCY_RING];     // el marco no entró al pool
+    atomic_uint_least32_t produced;             // marcos convertidos
+    atomic_uint_least32_t dropped;              // marcos perdidos con el pool lleno
+
+    uint32_t next_frame;                // secuencia del próximo marco a leer
+    uint32_t dropped_seen;              // perdidos que next_frame ya salteó
+    uint32_t dropped_at_reset;
+    uint32_t block_time;                // isr_time del marco en curso
+    uint32_t last_time;                 // fin de la última etapa
+    int recording;                      // el bloque en curso se acumula
+    int discard;                        // ignorar el próximo bloque
+    uint32_t blocks;
+    uint32_t deadline_misses;
+    uint64_t backlog_sum;               // marcos en el pool al tomar cada bloque
+    uint32_t backlog_max;
+    uint32_t lost_times;                // bloques sin instante: la cola dio la vuelta al anillo
+
+    // Impulso de prueba
+    int impulse_period;                 // bloques entre impulsos (0 = sin impulsos)
+    int impulse_timeout;                // bloques sin verlo en la salida para darlo por perdido
+    float impulse_level;
+    float impulse_threshold;            // salto de la salida que cuenta como detección
+    int impulse_countdown;
+    int impulse_pending;                // bloques desde la inyección + 1 (0 = ninguno)
+    uint32_t impulse_time;
+    float last_output;
+    uint32_t impulses_lost;
+    latency_hist_t impulse;
+} latency_probe_t;
+
+// block_period_us: muestras por bloque / frecuencia de muestreo.
+// bin_us: ancho de bin del histograma impreso del total (0 = 1/16 del plazo;
+// los 32 bins cubren dos plazos). Los percentiles no dependen de él.
+void latency_probe_init(latency_probe_t *p, float block_period_us, float bin_us);
+// Devuelve el índice de la etapa (1, 2, ...) o -1 si no entra
+int latency_probe_add_stage(latency_probe_t *p, const char *name);
+// period_blocks = 0 desactiva los impulsos
+void latency_probe_set_impulse(latency_probe_t *p, int period_blocks, float level, float threshold);
+// Borra las estadísticas; el próximo bloque no se cuenta (p.ej. después de
+// un reporte, que demora el lazo)
+void latency_probe_reset(latency_probe_t *p);
+
+// Desde el callback del ADC (sin llamadas: se puede usar en IRAM)
+static inline void latency_probe_isr(latency_probe_t *p)
+{
+    uint32_t seq = atomic_load_explicit(&p->produced, memory_order_relaxed);
+    atomic_store_explicit(&p->isr_time[seq % LATENCY_RING], latency_now(), memory_order_relaxed);
+    atomic_store_explicit(&p->isr_dropped[seq % LATENCY_RING], 0, memory_order_relaxed);
+    atomic_store_explicit(&p->produced, seq + 1, memory_order_release);
+}
+
+// Desde on_pool_ovf: el marco del último latency_probe_isr no entró al pool
+// (el driver llama a on_conv_done antes de encolar el marco y a on_pool_ovf
+// si no hubo lugar)
+static inline void latency_probe_isr_dropped(latency_probe_t *p)
+{
+    uint32_t seq = atomic_load_explicit(&p->produced, memory_order_relaxed) - 1;
+    atomic_store_explicit(&p->isr_dropped[seq % LATENCY_RING], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->dropped, 1, memory_order_release);
+}
+
+// Antes de leer un marco del driver
+void latency_probe_begin(latency_probe_t *p);
+void latency_probe_stage(latency_probe_t *p, int stage);
+// Con la primera muestra del bloque: devuelve x o el impulso si toca
+float latency_probe_inject(latency_probe_t *p, float x);
+// Con cada muestra que va al DAC, para detectar el impulso
+void latency_probe_output(latency_probe_t *p, float y);
+void latency_probe_end(latency_probe_t *p);
+
+// Tabla por etapa (media, mín, p99, máx en us), plazos, cola de marcos e
+// histograma del total (por printf)
+void latency_probe_report(const latency_probe_t *p, const char *title);
+
+#endif
@@ -0,0 +1,249 @@
+#include <string.h>
+#include <math.h>
+#include "lms.h"
+
+static void stats_reset(lms_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+static inline void stats_update(lms_stats_t *stats, float d, float e)
+{
+    stats->desired_power += LMS_STATS_ALPHA * (d * d - stats->desired_power);
+    stats->error_power += LMS_STATS_ALPHA * (e * e - stats->error_power);
+    stats->samples++;
+}
+
+float lms_stats_reduction_db(const lms_stats_t *stats)
+{
+    if (stats->error_power <= 0.0f || stats->desired_power <= 0.0f)
+        return 0.0f;
+    return 10.0f * log10f(stats->desired_power / stats->error_power);
+}
+
+// -------------------- NLMS --------------------
+size_t nlms_workspace_size(int num_taps)
+{
+    return 3 * (size_t)num_taps;
+}
+
+int nlms_init(nlms_t *nlms, int num_taps, float mu, float *workspace)
+{
+    if (num_taps < 1)
+        return -1;
+
+    memset(nlms, 0, sizeof(*nlms));
+    nlms->w = workspace;
+    nlms->mu = mu;
+    nlms->eps = 1e-6f;
+    fir_direct_init(&nlms->fir, nlms->w, num_taps, workspace + num_taps);
+    nlms_reset(nlms);
+    return 0;
+}
+
+nlms_t *nlms_create(dsp_arena_t *arena, int num_taps, float mu)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    nlms_t *nlms = dsp_arena_alloc(arena, sizeof(*nlms), 0, "nlms");
+    float *workspace = dsp_arena_alloc_floats(arena, nlms_workspace_size(num_taps), "nlms");
+    if (!nlms || !workspace || nlms_init(nlms, num_taps, mu, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return nlms;
+}
+
+void nlms_reset(nlms_t *nlms)
+{
+    memset(nlms->w, 0, nlms->fir.num_taps * sizeof(float));
+    fir_direct_reset(&nlms->fir);
+    nlms->energy = 0.0f;
+    stats_reset(&nlms->stats);
+}
+
+float nlms_sample(nlms_t *nlms, float x, float d)
+{
+    fir_direct_t *fir = &nlms->fir;
+    int taps = fir->num_taps;
+
+    // La más vieja sale de la ventana al empujar x
+    float oldest = fir->delay[fir->pos + taps - 1];
+    float y = fir_direct_sample(fir, x);
+    const float *xw = &fir->delay[fir->pos];
+
+    if (fir->pos == 0) {
+        float energy = 0.0f;
+        for (int i = 0; i < taps; i++)
+            energy += xw[i] * xw[i];
+        nlms->energy = energy;
+    } else {
+        nlms->energy += x * x - oldest * oldest;
+        if (nlms->energy < 0.0f)
+            nlms->energy = 0.0f;
+    }
+
+    float e = d - y;
+    float g = nlms->mu * e / (nlms->eps + nlms->energy);
+    for (int i = 0; i < taps; i++)
+        nlms->w[i] += g * xw[i];
+
+    stats_update(&nlms->stats, d, e);
+    return e;
+}
+
+void nlms_process(nlms_t *nlms, const float *x, const float *d, float *e, int n)
+{
+    for (int i = 0; i < n; i++)
+        e[i] = nlms_sample(nlms, x[i], d[i]);
+}
+// -------------------- NLMS --------------------
+
+// -------------------- LMS EN FRECUENCIA (FBLMS) --------------------
+size_t fblms_workspace_size(int num_taps)
+{
+    size_t B = num_taps;
+    return FFT_PLAN_TWIDDLE_SIZE(B) + 4 * (2 * B) + (B + 1) + 3 * B;
+}
+
+int fblms_init(fblms_t *f, int num_taps, float mu, float *workspace)
+{
+    if (num_taps < 2 || (num_taps & (num_taps - 1)))
+        return -1;
+
+    int B = num_taps;
+    memset(f, 0, sizeof(*f));
+    f->block = B;
+    f->mu = mu;
+    f->eps = 1e-6f;
+    f->power_alpha = 0.2f;
+
+    float *w = workspace;
+    if (fft_plan_init(&f->plan, B, w) != 0)
+        return -1;
+    w += FFT_PLAN_TWIDDLE_SIZE(B);
+    f->W = w;       w += 2 * B;
+    f->X = w;       w += 2 * B;
+    f->time = w;    w += 2 * B;
+    f->tmp = w;     w += 2 * B;
+    f->power = w;   w += B + 1;
+    f->x_fifo = w;  w += B;
+    f->d_fifo = w;  w += B;
+    f->e_fifo = w;
+
+    fblms_reset(f);
+    return 0;
+}
+
+fblms_t *fblms_create(dsp_arena_t *arena, int num_taps, float mu)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    fblms_t *f = dsp_arena_alloc(arena, sizeof(*f), 0, "fblms");
+    float *workspace = dsp_arena_alloc_floats(arena, fblms_workspace_size(num_taps), "fblms");
+    if (!f || !workspace || fblms_init(f, num_taps, mu, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return f;
+}
+
+void fblms_reset(fblms_t *f)
+{
+    int B = f->block;
+    f->fill = 0;
+    memset(f->W, 0, 2 * B * sizeof(float));
+    memset(f->time, 0, 2 * B * sizeof(float));
+    memset(f->power, 0, (B + 1) * sizeof(float));
+    memset(f->e_fifo, 0, B * sizeof(float));
+    stats_reset(&f->stats);
+}
+
+int fblms_latency(const fblms_t *f)
+{
+    return f->block;
+}
+
+// out = a * b para espectros empaquetados (DC y Nyquist son reales)
+static void spectrum_mul(float *out, const float *a, const float *b, int B)
+{
+    out[0] = a[0] * b[0];
+    out[1] = a[1] * b[1];
+    for (int k = 1; k < B; k++) {
+        float ar = a[2 * k], ai = a[2 * k + 1];
+        float br = b[2 * k], bi = b[2 * k + 1];
+        out[2 * k]     = ar * br - ai * bi;
+        out[2 * k + 1] = ar * bi + ai * br;
+    }
+}
+
+static void process_block(fblms_t *f)
+{
+    int B = f->block;
+    float *X = f->X, *tmp = f->tmp, *P = f->power;
+
+    // Ventana de 2B de la referencia: bloque anterior + bloque nuevo
+    memmove(f->time, f->time + B, B * sizeof(float));
+    memcpy(f->time + B, f->x_fifo, B * sizeof(float));
+    memcpy(X, f->time, 2 * B * sizeof(float));
+    fft_plan_forward_real(&f->plan, X);
+
+    // y = últimas B muestras de IFFT(X * W)
+    spectrum_mul(tmp, X, f->W, B);
+    fft_plan_inverse_real(&f->plan, tmp);
+    for (int i = 0; i < B; i++) {
+        float d = f->d_fifo[i];
+        float e = d - tmp[B + i];
+        f->e_fifo[i] = e;
+        stats_update(&f->stats, d, e);
+    }
+
+    // E = FFT([0, e])
+    memset(tmp, 0, B * sizeof(float));
+    memcpy(tmp + B, f->e_fifo, B * sizeof(float));
+    fft_plan_forward_real(&f->plan, tmp);
+
+    // Potencia por bin y gradiente normalizado conj(X) * E / P
+    float a = f->power_alpha;
+    P[0] += a * (X[0] * X[0] - P[0]);
+    P[B] += a * (X[1] * X[1] - P[B]);
+    tmp[0] = X[0] * tmp[0] / (P[0] + f->eps);
+    tmp[1] = X[1] * tmp[1] / (P[B] + f->eps);
+    for (int k = 1; k < B; k++) {
+        float xr = X[2 * k], xi = X[2 * k + 1];
+        float er = tmp[2 * k], ei = tmp[2 * k + 1];
+        P[k] += a * (xr * xr + xi * xi - P[k]);
+        float inv = 1.0f / (P[k] + f->eps);
+        tmp[2 * k]     = (xr * er + xi * ei) * inv;
+        tmp[2 * k + 1] = (xr * ei - xi * er) * inv;
+    }
+
+    // Restricción: el gradiente en el tiempo sólo puede tener B coeficientes
+    fft_plan_inverse_real(&f->plan, tmp);
+    memset(tmp + B, 0, B * sizeof(float));
+    fft_plan_forward_real(&f->plan, tmp);
+
+    float mu = f->mu;
+    for (int i = 0; i < 2 * B; i++)
+        f->W[i] += mu * tmp[i];
+}
+
+void fblms_process(fblms_t *f, const float *x, const float *d, float *e, int n)
+{
+    for (int i = 0; i < n; i++) {
+        f->x_fifo[f->fill] = x[i];
+        f->d_fifo[f->fill] = d[i];
+        e[i] = f->e_fifo[f->fill];
+        if (++f->fill == f->block) {
+            process_block(f);
+            f->fill = 0;
+        }
+    }
+}
+
+void fblms_get_coeffs(fblms_t *f, float *coeffs)
+{
+    int B = f->block;
+    memcpy(f->tmp, f->W, 2 * B * sizeof(float));
+    fft_plan_inverse_real(&f->plan, f->tmp);
+    memcpy(coeffs, f->tmp, B * sizeof(float));
+}
+// -------------------- LMS EN FRECUENCIA (FBLMS) --------------------
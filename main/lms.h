@@ -0,0 +1,87 @@
+#ifndef LMS_H
+#define LMS_H
+
+#include <stddef.h>
+#include "firFast.h"
+#include "fftPlan.h"
+#include "dspArena.h"
+
+// -------------------- FILTROS ADAPTATIVOS --------------------
+// Cancelación de ruido: x es la referencia (p.ej. ADC_CHANNEL_7), d la señal
+// primaria (ADC_CHANNEL_6). El filtro w estima el ruido de d a partir de x y
+// la salida útil es el error e = d - w*x.
+
+// Métricas de convergencia: promedios exponenciales de d^2 y e^2 con
+// constante LMS_STATS_ALPHA (~1/alpha muestras).
+#define LMS_STATS_ALPHA     (1.0f / 1024.0f)
+
+typedef struct {
+    float desired_power;
+    float error_power;
+    unsigned long samples;
+} lms_stats_t;
+
+// Atenuación lograda (10*log10(d^2 / e^2)); crece mientras el filtro converge
+float lms_stats_reduction_db(const lms_stats_t *stats);
+
+// -------------------- NLMS --------------------
+// Por muestra, sobre la línea de retardo de fir_direct (los coeficientes
+// adaptados son los de la FIR). mu en (0, 2); ~0.1 es un buen punto de partida.
+// La energía de la ventana se actualiza en O(1) y se recalcula entera cada
+// num_taps muestras para que no acumule error de redondeo.
+typedef struct {
+    fir_direct_t fir;
+    float *w;               // num_taps coeficientes (fir.coeffs)
+    float mu;
+    float eps;              // evita dividir por cero con la referencia en silencio
+    float energy;           // sum x^2 sobre la ventana
+    lms_stats_t stats;
+} nlms_t;
+
+// floats de workspace: w + línea de retardo duplicada
+size_t nlms_workspace_size(int num_taps);
+int nlms_init(nlms_t *nlms, int num_taps, float mu, float *workspace);
+// Objeto + workspace desde la arena. NULL si no alcanza.
+nlms_t *nlms_create(dsp_arena_t *arena, int num_taps, float mu);
+// Pone w en cero y vacía la línea de retardo y las métricas
+void nlms_reset(nlms_t *nlms);
+// Devuelve el error e = d - y y adapta w
+float nlms_sample(nlms_t *nlms, float x, float d);
+void nlms_process(nlms_t *nlms, const float *x, const float *d, float *e, int n);
+
+// -------------------- LMS EN FRECUENCIA (FBLMS) --------------------
+// LMS por bloques con overlap-save (restringido): num_taps = B coeficientes,
+// FFT real de 2B puntos con fftPlan y paso normalizado por la potencia de
+// cada bin. Cuesta 5 FFT de 2B por cada B muestras en vez de 2*B productos
+// por muestra, así que sirve para filtros largos a 50 kHz.
+// Igual que fir_fast, la salida sale con B muestras de retardo.
+typedef struct {
+    int block;              // B (= num_taps, potencia de 2)
+    int fill;
+    float mu;
+    float eps;
+    float power_alpha;      // promedio de la potencia por bin
+    fft_plan_t plan;        // n = B complejos -> FFT real de 2B
+    float *W;               // coeficientes en frecuencia (empaquetado, 2B)
+    float *X;               // espectro de la ventana de referencia (2B)
+    float *time;            // últimas 2B muestras de referencia
+    float *tmp;             // 2B
+    float *power;           // B+1 bins (DC .. Nyquist)
+    float *x_fifo;          // B
+    float *d_fifo;          // B
+    float *e_fifo;          // B
+    lms_stats_t stats;
+} fblms_t;
+
+size_t fblms_workspace_size(int num_taps);
+// num_taps: potencia de 2 >= 2. Devuelve 0 si OK, -1 si no sirve.
+int fblms_init(fblms_t *f, int num_taps, float mu, float *workspace);
+fblms_t *fblms_create(dsp_arena_t *arena, int num_taps, float mu);
+void fblms_reset(fblms_t *f);
+int fblms_latency(const fblms_t *f);
+void fblms_process(fblms_t *f, const float *x, const float *d, float *e, int n);
+// Coeficientes actuales en el tiempo (num_taps floats), para inspección.
+// Usa tmp de trabajo: no llamar en medio de fblms_process desde otra tarea.
+void fblms_get_coeffs(fblms_t *f, float *coeffs);
+
+#endif
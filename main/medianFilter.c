@@ -0,0 +1,210 @@
+#include <string.h>
+#include <math.h>
+#include "medianFilter.h"
+
+// Los índices de los montículos van en el mismo workspace de floats
+_Static_assert(sizeof(int32_t) == sizeof(float), "int32_t y float deben medir lo mismo");
+
+// -------------------- RED DE ORDENAMIENTO --------------------
+// Bose-Nelson: ordena las dos mitades y las mezcla recursivamente
+static void add_comparator(median_filter_t *m, int i, int j)
+{
+    m->comparators[m->num_comparators][0] = (uint8_t)i;
+    m->comparators[m->num_comparators][1] = (uint8_t)j;
+    m->num_comparators++;
+}
+
+static void network_merge(median_filter_t *m, int i, int x, int j, int y)
+{
+    if (x == 1 && y == 1) {
+        add_comparator(m, i, j);
+    } else if (x == 1 && y == 2) {
+        add_comparator(m, i, j + 1);
+        add_comparator(m, i, j);
+    } else if (x == 2 && y == 1) {
+        add_comparator(m, i, j);
+        add_comparator(m, i + 1, j);
+    } else {
+        int a = x / 2;
+        int b = (x & 1) ? y / 2 : (y + 1) / 2;
+        network_merge(m, i, a, j, b);
+        network_merge(m, i + a, x - a, j + b, y - b);
+        network_merge(m, i + a, x - a, j, b);
+    }
+}
+
+static void network_sort(median_filter_t *m, int i, int n)
+{
+    if (n < 2)
+        return;
+    int a = n / 2;
+    network_sort(m, i, a);
+    network_sort(m, i + a, n - a);
+    network_merge(m, i, a, i + a, n - a);
+}
+// -------------------- RED DE ORDENAMIENTO --------------------
+
+size_t median_filter_workspace_size(int window)
+{
+    // ventana + montículos + posiciones (o ventana + copia ordenada)
+    return 3 * (size_t)window;
+}
+
+int median_filter_init(median_filter_t *m, int window, float percentile, float *workspace)
+{
+    if (window < 1 || !(percentile >= 0.0f && percentile <= 1.0f))
+        return -1;
+
+    memset(m, 0, sizeof(*m));
+    m->window = window;
+    float position = percentile * (window - 1);
+    m->rank = (int)position;
+    if (m->rank > window - 1)
+        m->rank = window - 1;
+    m->frac = (m->rank < window - 1) ? position - m->rank : 0.0f;
+    m->values = workspace;
+
+    if (window <= MEDIAN_NETWORK_MAX) {
+        network_sort(m, 0, window);
+        m->sorted = workspace + window;
+    } else {
+        m->num_lo = m->rank + 1;
+        m->num_hi = window - m->num_lo;
+        m->lo = (int32_t *)(workspace + window);
+        m->hi = m->lo + m->num_lo;
+        m->slot = m->lo + window;
+    }
+    median_filter_reset(m);
+    return 0;
+}
+
+median_filter_t *median_filter_create(dsp_arena_t *arena, int window, float percentile)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    median_filter_t *m = dsp_arena_alloc(arena, sizeof(*m), 0, "median_filter");
+    float *workspace = (window >= 1)
+        ? dsp_arena_alloc_floats(arena, median_filter_workspace_size(window), "median_filter")
+        : NULL;
+    if (!m || !workspace || median_filter_init(m, window, percentile, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return m;
+}
+
+void median_filter_reset(median_filter_t *m)
+{
+    m->pos = 0;
+    memset(m->values, 0, m->window * sizeof(float));
+    if (m->num_comparators || m->window == 1)
+        return;
+    // Todo en cero: cualquier reparto es un montículo válido
+    for (int i = 0; i < m->num_lo; i++) {
+        m->lo[i] = i;
+        m->slot[i] = i;
+    }
+    for (int i = 0; i < m->num_hi; i++) {
+        m->hi[i] = m->num_lo + i;
+        m->slot[m->num_lo + i] = -(i + 1);
+    }
+}
+
+// -------------------- MONTÍCULOS --------------------
+// lo es de máximo y hi de mínimo: se usa el mismo código con el signo
+// invertido en la comparación (sign = 1 en lo, -1 en hi)
+static inline int heap_before(const float *v, int32_t a, int32_t b, float sign)
+{
+    return sign * v[a] > sign * v[b];
+}
+
+static inline void heap_place(median_filter_t *m, int32_t *heap, float sign, int p, int32_t s)
+{
+    heap[p] = s;
+    m->slot[s] = (sign > 0.0f) ? p : -(p + 1);
+}
+
+static void heap_sift(median_filter_t *m, int32_t *heap, int size, float sign, int p)
+{
+    const float *v = m->values;
+    int32_t s = heap[p];
+
+    // Hacia arriba
+    while (p > 0 && heap_before(v, s, heap[(p - 1) / 2], sign)) {
+        heap_place(m, heap, sign, p, heap[(p - 1) / 2]);
+        p = (p - 1) / 2;
+    }
+    // Hacia abajo
+    for (;;) {
+        int c = 2 * p + 1;
+        if (c >= size)
+            break;
+        if (c + 1 < size && heap_before(v, heap[c + 1], heap[c], sign))
+            c++;
+        if (!heap_before(v, heap[c], s, sign))
+            break;
+        heap_place(m, heap, sign, p, heap[c]);
+        p = c;
+    }
+    heap_place(m, heap, sign, p, s);
+}
+
+static float heap_update(median_filter_t *m, int s)
+{
+    int p = m->slot[s];
+    if (p >= 0)
+        heap_sift(m, m->lo, m->num_lo, 1.0f, p);
+    else
+        heap_sift(m, m->hi, m->num_hi, -1.0f, -p - 1);
+
+    // Si los topes se cruzaron alcanza con intercambiarlos (cambió un solo valor)
+    const float *v = m->values;
+    if (m->num_hi && v[m->lo[0]] > v[m->hi[0]]) {
+        int32_t a = m->lo[0], b = m->hi[0];
+        heap_place(m, m->lo, 1.0f, 0, b);
+        heap_place(m, m->hi, -1.0f, 0, a);
+        heap_sift(m, m->lo, m->num_lo, 1.0f, 0);
+        heap_sift(m, m->hi, m->num_hi, -1.0f, 0);
+    }
+
+    float y = v[m->lo[0]];
+    if (m->frac > 0.0f)
+        y += m->frac * (v[m->hi[0]] - y);
+    return y;
+}
+// -------------------- MONTÍCULOS --------------------
+
+static float network_update(median_filter_t *m)
+{
+    float *w = m->sorted;
+    memcpy(w, m->values, m->window * sizeof(float));
+    for (int c = 0; c < m->num_comparators; c++) {
+        int i = m->comparators[c][0], j = m->comparators[c][1];
+        float a = w[i], b = w[j];
+        w[i] = a < b ? a : b;
+        w[j] = a > b ? a : b;
+    }
+    float y = w[m->rank];
+    if (m->frac > 0.0f)
+        y += m->frac * (w[m->rank + 1] - y);
+    return y;
+}
+
+float median_filter(median_filter_t *m, float new_sample)
+{
+    int s = m->pos;
+    m->values[s] = new_sample;
+    if (++m->pos == m->window)
+        m->pos = 0;
+
+    if (m->window == 1)
+        return new_sample;
+    if (m->num_comparators)
+        return network_update(m);
+    return heap_update(m, s);
+}
+
+void median_filter_process(median_filter_t *m, const float *in, float *out, int count)
+{
+    for (int i = 0; i < count; i++)
+        out[i] = median_filter(m, in[i]);
+}
@@ -0,0 +1,60 @@
+#ifndef MEDIAN_FILTER_H
+#define MEDIAN_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dspArena.h"
+
+// -------------------- MEDIANA Y PERCENTILES DESLIZANTES --------------------
+// Percentil q de las últimas N muestras, muestra a muestra. A diferencia del
+// promedio, un pico aislado no se desparrama sobre la salida: mientras
+// ocupe menos de la mitad de la ventana, la mediana lo ignora.
+//
+// Con q entre dos rangos se interpola linealmente: posición q*(N-1) en la
+// ventana ordenada (q = 0.5 con N par da el promedio de los dos del medio).
+//
+// N > MEDIAN_NETWORK_MAX: dos montículos sobre la ventana, uno de máximo
+// con las k+1 menores y uno de mínimo con el resto (k = floor(q*(N-1))).
+// Cada muestra nueva pisa a la más vieja en su montículo, se reacomoda y,
+// si los topes quedaron cruzados, se intercambian: O(log N) por muestra.
+// N <= MEDIAN_NETWORK_MAX: red de ordenamiento (Bose-Nelson, sin saltos,
+// sólo mínimos y máximos) sobre una copia de la ventana, que para ventanas
+// chicas es más rápida que los montículos (en un x86-64 gana hasta N = 8;
+// con N = 9 ya pierde por ~7 %).
+//
+// El estado arranca en cero, igual que la línea de retardo de las FIR.
+
+#define MEDIAN_NETWORK_MAX          8
+#define MEDIAN_MAX_COMPARATORS      32
+
+typedef struct {
+    int window;                 // N
+    int rank;                   // k
+    float frac;                 // peso del rango k+1
+    int pos;                    // muestra más vieja en values
+    float *values;              // ventana (circular)
+
+    // Montículos: índices de values; slot[i] = posición de values[i], >= 0 en
+    // lo, -(posición + 1) en hi
+    int num_lo, num_hi;
+    int32_t *lo;                // máximo en lo[0]
+    int32_t *hi;                // mínimo en hi[0]
+    int32_t *slot;
+
+    // Red de ordenamiento
+    int num_comparators;        // 0 = se usan los montículos
+    uint8_t comparators[MEDIAN_MAX_COMPARATORS][2];
+    float *sorted;
+} median_filter_t;
+
+size_t median_filter_workspace_size(int window);
+// percentile entre 0 y 1 (0.5 = mediana). Devuelve 0 si OK, -1 si no sirve.
+int median_filter_init(median_filter_t *m, int window, float percentile, float *workspace);
+median_filter_t *median_filter_create(dsp_arena_t *arena, int window, float percentile);
+void median_filter_reset(median_filter_t *m);
+
+float median_filter(median_filter_t *m, float new_sample);
+// in y out pueden ser el mismo buffer
+void median_filter_process(median_filter_t *m, const float *in, float *out, int count);
+
+#endif
@@ -0,0 +1,211 @@
+#include <string.h>
+#include <math.h>
+#include "octaveBank.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Bilineal con T = 1: s = 2 (z - 1) / (z + 1), frecuencias predeformadas w = 2 tan(pi f / fs)
+#define BILINEAR_K 2.0
+
+// Sección analógica (num2 s^2 + num1 s + num0) / (s^2 + alpha s + beta) a
+// digital; gain normaliza |H| a 1 en la frecuencia digital theta (rad/muestra)
+static void bilinear_section(double num2, double num1, double num0, double alpha, double beta,
+                             double theta, float *b, float *a, float *gain)
+{
+    double k = BILINEAR_K, k2 = k * k;
+    double a0 = k2 + alpha * k + beta;
+    double b0 = (num2 * k2 + num1 * k + num0) / a0;
+    double b1 = (2.0 * num0 - 2.0 * num2 * k2) / a0;
+    double b2 = (num2 * k2 - num1 * k + num0) / a0;
+    double a1 = (2.0 * beta - 2.0 * k2) / a0;
+    double a2 = (k2 - alpha * k + beta) / a0;
+
+    // H(e^{j theta}) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+    double c1 = cos(theta), s1 = sin(theta), c2 = cos(2.0 * theta), s2 = sin(2.0 * theta);
+    double nr = b0 + b1 * c1 + b2 * c2, ni = -b1 * s1 - b2 * s2;
+    double dr = 1.0 + a1 * c1 + a2 * c2, di = -a1 * s1 - a2 * s2;
+    double mag = sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+
+    b[0] = (float)b0; b[1] = (float)b1; b[2] = (float)b2;
+    a[0] = 1.0f;      a[1] = (float)a1; a[2] = (float)a2;
+    *gain = (float)(1.0 / mag);
+}
+
+// Pasabanda Butterworth de orden 2 * OCTAVE_BAND_SOS entre f1 y f2 (fracción de fs).
+// Cada polo p del pasabajos prototipo da s^2 - p B s + w0^2 = 0; las raíces
+// complejas con su conjugada forman una sección con numerador B s.
+static void design_bandpass(float f1, float f2, float *bx, float *by, float *gain)
+{
+    double w1 = BILINEAR_K * tan(M_PI * f1), w2 = BILINEAR_K * tan(M_PI * f2);
+    double w0sq = w1 * w2, bw = w2 - w1;
+    double theta0 = 2.0 * atan(sqrt(w0sq) / BILINEAR_K);
+    int n = OCTAVE_BAND_SOS, s = 0;
+
+    for (int k = 0; k < n; k++) {
+        double angle = M_PI * (2 * k + n + 1) / (2.0 * n);
+        double pr = cos(angle), pi = sin(angle);
+        if (pi < -1e-9)
+            continue;                               // conjugado de uno ya usado
+        if (pi < 1e-9) {
+            // Polo real: la sección es directamente s^2 + |p| B s + w0^2
+            bilinear_section(0.0, bw, 0.0, -pr * bw, w0sq, theta0, &bx[3 * s], &by[3 * s], &gain[s]);
+            s++;
+            continue;
+        }
+        // s = (pB +- sqrt(p^2 B^2 - 4 w0^2)) / 2, en complejos
+        double qr = (pr * pr - pi * pi) * bw * bw - 4.0 * w0sq, qi = 2.0 * pr * pi * bw * bw;
+        double mod = sqrt(sqrt(qr * qr + qi * qi));
+        double arg = 0.5 * atan2(qi, qr);
+        double sr = mod * cos(arg), si = mod * sin(arg);
+        for (int sign = -1; sign <= 1; sign += 2) {
+            double rr = 0.5 * (pr * bw + sign * sr), ri = 0.5 * (pi * bw + sign * si);
+            bilinear_section(0.0, bw, 0.0, -2.0 * rr, rr * rr + ri * ri, theta0,
+                             &bx[3 * s], &by[3 * s], &gain[s]);
+            s++;
+        }
+    }
+}
+
+// Pasabajos Butterworth de orden 2 * OCTAVE_AA_SOS, ganancia 1 en DC
+static void design_lowpass(float fc, float *bx, float *by, float *gain)
+{
+    double wc = BILINEAR_K * tan(M_PI * fc);
+    for (int s = 0; s < OCTAVE_AA_SOS; s++) {
+        double angle = M_PI * (2 * s + 1) / (4.0 * OCTAVE_AA_SOS);
+        double alpha = 2.0 * sin(angle) * wc;
+        bilinear_section(0.0, 0.0, wc * wc, alpha, wc * wc, 0.0, &bx[3 * s], &by[3 * s], &gain[s]);
+    }
+}
+
+static void attach_sos(iir_sos_state_t *iir, const float *bx, const float *by, const float *gain,
+                       int num_sos, float **workspace)
+{
+    iir->coeffs_x = bx;
+    iir->coeffs_y = by;
+    iir->gain = gain;
+    iir->num_sos = num_sos;
+    iir->x_buffer = *workspace;
+    iir->y_buffer = *workspace + 2 * num_sos;
+    *workspace += 4 * num_sos;
+}
+
+size_t octave_bank_workspace_size(int num_octaves, int fraction)
+{
+    // x_buffer e y_buffer de cada cascada
+    return 4 * ((size_t)num_octaves * fraction * OCTAVE_BAND_SOS +
+                (size_t)(num_octaves - 1) * OCTAVE_AA_SOS);
+}
+
+int octave_bank_init(octave_bank_t *bank, float fs, float top_hz, int num_octaves, int fraction,
+                     uint32_t window, float *workspace)
+{
+    float half_band = powf(2.0f, 0.5f / fraction);
+    if (num_octaves < 1 || num_octaves > OCTAVE_MAX_OCTAVES || fraction < 1 ||
+        fraction > OCTAVE_MAX_FRACTION || !(fs > 0.0f) || !(top_hz > 0.0f) ||
+        top_hz * half_band > 0.25f * fs || window == 0)
+        return -1;
+
+    memset(bank, 0, sizeof(*bank));
+    bank->num_octaves = num_octaves;
+    bank->fraction = fraction;
+    bank->num_bands = num_octaves * fraction;
+    bank->fs = fs;
+
+    uint32_t align = 1u << (num_octaves - 1);
+    bank->window = (window + align - 1) / align * align;
+
+    // Bandas de la octava de arriba, j = 0 la más alta
+    for (int j = 0; j < fraction; j++) {
+        float fc = top_hz * powf(2.0f, -(float)j / fraction) / fs;
+        design_bandpass(fc / half_band, fc * half_band, bank->band_x[j], bank->band_y[j], bank->band_gain[j]);
+    }
+    design_lowpass(OCTAVE_AA_CUTOFF, bank->aa_x, bank->aa_y, bank->aa_gain);
+
+    for (int level = 0; level < num_octaves; level++) {
+        for (int j = 0; j < fraction; j++) {
+            int band = (num_octaves - 1 - level) * fraction + (fraction - 1 - j);
+            bank->center_hz[band] = top_hz * powf(2.0f, -(float)j / fraction - level);
+            attach_sos(&bank->bands[band], bank->band_x[j], bank->band_y[j], bank->band_gain[j],
+                       OCTAVE_BAND_SOS, &workspace);
+        }
+        if (level < num_octaves - 1)
+            attach_sos(&bank->aa[level], bank->aa_x, bank->aa_y, bank->aa_gain, OCTAVE_AA_SOS, &workspace);
+    }
+
+    octave_bank_reset(bank);
+    return 0;
+}
+
+octave_bank_t *octave_bank_create(dsp_arena_t *arena, float fs, float top_hz, int num_octaves,
+                                  int fraction, uint32_t window)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    octave_bank_t *bank = dsp_arena_alloc(arena, sizeof(*bank), 0, "octave_bank");
+    float *workspace = (num_octaves >= 1 && fraction >= 1)
+        ? dsp_arena_alloc_floats(arena, octave_bank_workspace_size(num_octaves, fraction), "octave_bank")
+        : NULL;
+    if (!bank || !workspace ||
+        octave_bank_init(bank, fs, top_hz, num_octaves, fraction, window, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return bank;
+}
+
+void octave_bank_reset(octave_bank_t *bank)
+{
+    for (int b = 0; b < bank->num_bands; b++)
+        iir_sos_reset(&bank->bands[b]);
+    for (int level = 0; level < bank->num_octaves - 1; level++)
+        iir_sos_reset(&bank->aa[level]);
+    bank->tick = 0;
+    memset(bank->energy, 0, sizeof(bank->energy));
+    memset(bank->rms, 0, sizeof(bank->rms));
+}
+
+int octave_bank_process(octave_bank_t *bank, const float *x, int count)
+{
+    int windows = 0;
+    int last = bank->num_octaves - 1;
+    int fraction = bank->fraction;
+
+    for (int i = 0; i < count; i++) {
+        // La octava level recibe una muestra cada 2^level de entrada
+        float xl = x[i];
+        for (int level = 0; ; level++) {
+            int top = (last - level) * fraction + fraction - 1;
+            for (int j = 0; j < fraction; j++) {
+                float y = iir_sos_filter(&bank->bands[top - j], xl);
+                bank->energy[top - j] += y * y;
+            }
+            if (level == last)
+                break;
+            xl = iir_sos_filter(&bank->aa[level], xl);
+            if ((bank->tick >> level) & 1)
+                break;
+        }
+
+        if (++bank->tick == bank->window) {
+            for (int level = 0; level <= last; level++) {
+                float inv = (float)(1u << level) / bank->window;
+                for (int j = 0; j < fraction; j++) {
+                    int band = (last - level) * fraction + j;
+                    bank->rms[band] = sqrtf(bank->energy[band] * inv);
+                    bank->energy[band] = 0.0f;
+                }
+            }
+            bank->tick = 0;
+            windows++;
+        }
+    }
+    return windows;
+}
+
+float octave_bank_level_db(const octave_bank_t *bank, int band, float ref)
+{
+    // Un seno de amplitud ref tiene RMS ref / sqrt(2)
+    float rms = bank->rms[band] * 1.41421356f / ref;
+    return 20.0f * log10f(rms > 1e-10f ? rms : 1e-10f);
+}
@@ -0,0 +1,80 @@
+#ifndef OCTAVE_BANK_H
+#define OCTAVE_BANK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "filterKernels.h"
+#include "dspArena.h"
+
+// -------------------- BANCO DE OCTAVAS --------------------
+// Niveles por bandas de 1/1 o 1/3 de octava (base 2) con un árbol de
+// decimación por 2: la octava más alta se filtra a fs, después pasabajos y
+// ÷2, la siguiente octava a fs/2 con los MISMOS pasabanda (en frecuencia
+// normalizada es la misma banda), y así. Cada octava cuesta la mitad que la
+// anterior, así que el total queda en menos del doble de una octava
+// (fraction * OCTAVE_BAND_SOS + OCTAVE_AA_SOS secciones) sin importar cuántas
+// octavas haya. Además las bandas bajas no se diseñan a frecuencias
+// normalizadas diminutas, donde los polos quedan pegados al círculo unidad.
+//
+// Pasabanda: Butterworth de orden 2*OCTAVE_BAND_SOS (3 secciones, como la
+// clase 1 de IEC 61260), ganancia 1 en la frecuencia central.
+// Antialias: Butterworth de orden 2*OCTAVE_AA_SOS con corte en
+// OCTAVE_AA_CUTOFF * fs del nivel. La banda más alta tiene que terminar
+// debajo de fs/4: la octava siguiente queda debajo de fs/8, donde el
+// pasabajos es plano, y lo que se pliega sobre ella (arriba de 3fs/8) queda
+// más de 50 dB abajo.
+//
+// Todos los filtros son iir_sos_state_t de filterKernels (iir_sos_filter).
+// Las bandas van de la más baja (0) a la más alta. El RMS de cada banda se
+// integra en ventanas de window muestras de entrada (redondeadas a múltiplo
+// de 2^(octavas-1) para que cada octava vea un número entero de muestras).
+
+#define OCTAVE_MAX_OCTAVES      10
+#define OCTAVE_MAX_FRACTION     3
+#define OCTAVE_MAX_BANDS        (OCTAVE_MAX_OCTAVES * OCTAVE_MAX_FRACTION)
+#define OCTAVE_BAND_SOS         3
+#define OCTAVE_AA_SOS           4
+#define OCTAVE_AA_CUTOFF        0.22f
+
+typedef struct {
+    int num_octaves;
+    int fraction;                   // 1 = octavas, 3 = tercios
+    int num_bands;
+    float fs;
+    float center_hz[OCTAVE_MAX_BANDS];
+
+    // Prototipos a la tasa de entrada, compartidos por todas las octavas
+    float band_x[OCTAVE_MAX_FRACTION][3 * OCTAVE_BAND_SOS];
+    float band_y[OCTAVE_MAX_FRACTION][3 * OCTAVE_BAND_SOS];
+    float band_gain[OCTAVE_MAX_FRACTION][OCTAVE_BAND_SOS];
+    float aa_x[3 * OCTAVE_AA_SOS];
+    float aa_y[3 * OCTAVE_AA_SOS];
+    float aa_gain[OCTAVE_AA_SOS];
+
+    // Estado: una cascada por banda y un antialias por octava (menos la última)
+    iir_sos_state_t bands[OCTAVE_MAX_BANDS];
+    iir_sos_state_t aa[OCTAVE_MAX_OCTAVES - 1];
+
+    uint32_t tick;                  // muestras de entrada en la ventana
+    uint32_t window;
+    float energy[OCTAVE_MAX_BANDS];
+    float rms[OCTAVE_MAX_BANDS];    // de la última ventana completa
+} octave_bank_t;
+
+size_t octave_bank_workspace_size(int num_octaves, int fraction);
+// top_hz: centro de la banda más alta (su borde superior <= fs/4); las demás
+// son top_hz * 2^(-k/fraction). window en muestras de entrada.
+// Devuelve 0 si OK, -1 si los parámetros no sirven.
+int octave_bank_init(octave_bank_t *bank, float fs, float top_hz, int num_octaves, int fraction,
+                     uint32_t window, float *workspace);
+octave_bank_t *octave_bank_create(dsp_arena_t *arena, float fs, float top_hz, int num_octaves,
+                                  int fraction, uint32_t window);
+void octave_bank_reset(octave_bank_t *bank);
+
+// Devuelve la cantidad de ventanas completadas en el bloque (rms[] tiene la última)
+int octave_bank_process(octave_bank_t *bank, const float *x, int count);
+
+// Nivel de la banda en dB respecto de un seno de amplitud ref
+float octave_bank_level_db(const octave_bank_t *bank, int band, float ref);
+
+#endif
@@ -0,0 +1,103 @@
+#include <string.h>
+#include <math.h>
+#include "slidingDft.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+size_t sdft_workspace_size(int n, int num_bins)
+{
+    return 2 * (size_t)num_bins + 2 * (size_t)num_bins + n;
+}
+
+int sdft_init(sdft_t *s, int n, int num_bins, float damping, float *workspace)
+{
+    if (n < 2 || num_bins < 1 || num_bins > n || !(damping > 0.0f && damping <= 1.0f))
+        return -1;
+
+    memset(s, 0, sizeof(*s));
+    s->n = n;
+    s->num_bins = num_bins;
+    s->damping = damping;
+    s->damping_n = (float)pow(damping, n);
+    s->twiddle = workspace;
+    s->bins = workspace + 2 * num_bins;
+    s->ring = workspace + 4 * num_bins;
+
+    for (int k = 0; k < num_bins; k++) {
+        double angle = 2.0 * M_PI * k / n;
+        s->twiddle[2 * k] = (float)(damping * cos(angle));
+        s->twiddle[2 * k + 1] = (float)(damping * sin(angle));
+    }
+    sdft_reset(s);
+    return 0;
+}
+
+sdft_t *sdft_create(dsp_arena_t *arena, int n, int num_bins, float damping)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    sdft_t *s = dsp_arena_alloc(arena, sizeof(*s), 0, "sdft");
+    float *workspace = dsp_arena_alloc_floats(arena, sdft_workspace_size(n, num_bins), "sdft");
+    if (!s || !workspace || sdft_init(s, n, num_bins, damping, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return s;
+}
+
+void sdft_reset(sdft_t *s)
+{
+    s->pos = 0;
+    memset(s->bins, 0, 2 * s->num_bins * sizeof(float));
+    memset(s->ring, 0, s->n * sizeof(float));
+}
+
+void sdft_update(sdft_t *s, float x)
+{
+    // Entra x, sale la más vieja (atenuada r^N como el resto de la ventana)
+    float delta = x - s->damping_n * s->ring[s->pos];
+    s->ring[s->pos] = x;
+    if (++s->pos == s->n)
+        s->pos = 0;
+
+    const float *w = s->twiddle;
+    float *b = s->bins;
+    for (int k = 0; k < s->num_bins; k++) {
+        float re = b[2 * k] + delta;
+        float im = b[2 * k + 1];
+        b[2 * k]     = re * w[2 * k] - im * w[2 * k + 1];
+        b[2 * k + 1] = re * w[2 * k + 1] + im * w[2 * k];
+    }
+}
+
+void sdft_process(sdft_t *s, const float *x, int count)
+{
+    for (int i = 0; i < count; i++)
+        sdft_update(s, x[i]);
+}
+
+// Vecino k de la ventana circular; fuera de los bins calculados se usa la
+// simetría conjugada de la entrada real (S_{N-k} = conj(S_k))
+static void neighbour(const sdft_t *s, int k, float *re, float *im)
+{
+    k = (k + s->n) % s->n;
+    if (k < s->num_bins) {
+        *re = s->bins[2 * k];
+        *im = s->bins[2 * k + 1];
+    } else {
+        *re = s->bins[2 * (s->n - k)];
+        *im = -s->bins[2 * (s->n - k) + 1];
+    }
+}
+
+void sdft_windowed(const sdft_t *s, float *out)
+{
+    for (int k = 0; k < s->num_bins; k++) {
+        float lre, lim, rre, rim;
+        neighbour(s, k - 1, &lre, &lim);
+        neighbour(s, k + 1, &rre, &rim);
+        out[2 * k]     = 0.5f * s->bins[2 * k]     - 0.25f * (lre + rre);
+        out[2 * k + 1] = 0.5f * s->bins[2 * k + 1] - 0.25f * (lim + rim);
+    }
+}
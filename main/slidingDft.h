@@ -0,0 +1,52 @@
+#ifndef SLIDING_DFT_H
+#define SLIDING_DFT_H
+
+#include <stddef.h>
+#include "dspArena.h"
+
+// -------------------- DFT DESLIZANTE --------------------
+// Espectro de las últimas N muestras actualizado en cada muestra, en O(bins):
+//   S_k(n) = r e^{j 2 pi k / N} [S_k(n-1) + x(n) - r^N x(n-N)]
+// Con r = 1 es la DFT exacta de la ventana (igual que fft() sobre las N
+// muestras en orden), pero el redondeo se acumula sin límite; con r < 1 el
+// error viejo se olvida y los polos quedan dentro del círculo unidad, a
+// cambio de ponderar la muestra m de la ventana por r^(m+1) (con
+// SDFT_DEFAULT_DAMPING y N = 64 eso es < 0.1%).
+//
+// num_bins < N calcula sólo los bins 0 .. num_bins-1 (para entrada real
+// alcanza con N/2 + 1; el resto es el conjugado).
+//
+// La ventana de Hann se aplica en frecuencia: Y_k = 0.5 S_k - 0.25 (S_{k-1} + S_{k+1}).
+
+#define SDFT_DEFAULT_DAMPING    0.99999f
+
+typedef struct {
+    int n;                  // N (largo de la ventana)
+    int num_bins;
+    int pos;                // posición de la muestra más vieja en ring
+    float damping;          // r
+    float damping_n;        // r^N
+    float *twiddle;         // r e^{j 2 pi k / N}, num_bins complejos
+    float *bins;            // S_k intercalados (re, im), num_bins complejos
+    float *ring;            // últimas N muestras
+} sdft_t;
+
+size_t sdft_workspace_size(int n, int num_bins);
+// Devuelve 0 si OK, -1 si n o num_bins no sirven o damping no está en (0, 1]
+int sdft_init(sdft_t *s, int n, int num_bins, float damping, float *workspace);
+sdft_t *sdft_create(dsp_arena_t *arena, int n, int num_bins, float damping);
+void sdft_reset(sdft_t *s);
+
+// Actualiza todos los bins con la muestra nueva
+void sdft_update(sdft_t *s, float x);
+void sdft_process(sdft_t *s, const float *x, int count);
+
+// Bin k sin ventana (puntero a re, im)
+static inline const float *sdft_bin(const sdft_t *s, int k)
+{
+    return &s->bins[2 * k];
+}
+// Bins 0 .. num_bins-1 con ventana de Hann (out: num_bins complejos)
+void sdft_windowed(const sdft_t *s, float *out);
+
+#endif
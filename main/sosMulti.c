@@ -0,0 +1,121 @@
+#include <string.h>
+#include "sosMulti.h"
+
+#define L SOS_MULTI_LANES
+
+size_t sos_multi_workspace_size(int num_channels, int num_sos)
+{
+    size_t groups = ((size_t)num_channels + L - 1) / L;
+    return 6 * (size_t)num_sos + groups * num_sos * 4 * L;
+}
+
+int sos_multi_init(sos_multi_t *m, const float *coeffs_x, const float *coeffs_y, const float *gain,
+                   int num_sos, int num_channels, float *workspace)
+{
+    if (num_sos < 1 || num_channels < 1)
+        return -1;
+    for (int s = 0; s < num_sos; s++) {
+        if (coeffs_y[3 * s] == 0.0f)
+            return -1;
+    }
+
+    memset(m, 0, sizeof(*m));
+    m->num_channels = num_channels;
+    m->num_groups = (num_channels + L - 1) / L;
+    m->num_sos = num_sos;
+    m->coeffs = workspace;
+    m->state = workspace + 6 * num_sos;
+
+    for (int s = 0; s < num_sos; s++) {
+        const float *b = &coeffs_x[3 * s];
+        const float *a = &coeffs_y[3 * s];
+        float *c = &m->coeffs[6 * s];
+        if (a[0] == 1.0f) {
+            c[0] = b[0]; c[1] = b[1]; c[2] = b[2];
+            c[3] = a[1]; c[4] = a[2];
+        } else {
+            c[0] = b[0] / a[0]; c[1] = b[1] / a[0]; c[2] = b[2] / a[0];
+            c[3] = a[1] / a[0]; c[4] = a[2] / a[0];
+        }
+        c[5] = gain[s];
+    }
+    sos_multi_reset(m);
+    return 0;
+}
+
+sos_multi_t *sos_multi_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y,
+                              const float *gain, int num_sos, int num_channels)
+{
+    dsp_arena_mark_t mark = dsp_arena_mark(arena);
+    sos_multi_t *m = dsp_arena_alloc(arena, sizeof(*m), 0, "sos_multi");
+    float *workspace = (num_sos >= 1 && num_channels >= 1)
+        ? dsp_arena_alloc_floats(arena, sos_multi_workspace_size(num_channels, num_sos), "sos_multi")
+        : NULL;
+    if (!m || !workspace ||
+        sos_multi_init(m, coeffs_x, coeffs_y, gain, num_sos, num_channels, workspace) != 0) {
+        dsp_arena_rollback(arena, mark);
+        return NULL;
+    }
+    return m;
+}
+
+void sos_multi_reset(sos_multi_t *m)
+{
+    memset(m->state, 0, (size_t)m->num_groups * m->num_sos * 4 * L * sizeof(float));
+}
+
+// Un grupo de L canales, todas las muestras: el estado del grupo queda en
+// caché (y los carriles en registros) mientras se recorre el tiempo
+static inline void process_group(const sos_multi_t *m, float *state, const float *in, float *out,
+                                 int count, int first, int lanes)
+{
+    int stride = m->num_channels;
+
+    for (int n = 0; n < count; n++) {
+        float v[L];
+        const float *src = &in[n * stride + first];
+        if (lanes == L) {
+            for (int l = 0; l < L; l++)
+                v[l] = src[l];
+        } else {
+            for (int l = 0; l < L; l++)
+                v[l] = l < lanes ? src[l] : 0.0f;
+        }
+
+        for (int s = 0; s < m->num_sos; s++) {
+            const float *c = &m->coeffs[6 * s];
+            float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4], g = c[5];
+            float *x1 = &state[4 * L * s];
+            float *x2 = x1 + L;
+            float *y1 = x1 + 2 * L;
+            float *y2 = x1 + 3 * L;
+
+            // Misma ecuación y orden de operaciones que iir_sos_filter
+            for (int l = 0; l < L; l++) {
+                float y = b0 * v[l] + b1 * x1[l] + b2 * x2[l] - a1 * y1[l] - a2 * y2[l];
+                x2[l] = x1[l];
+                x1[l] = v[l];
+                y2[l] = y1[l];
+                y1[l] = y;
+                v[l] = y * g;
+            }
+        }
+
+        float *dst = &out[n * stride + first];
+        for (int l = 0; l < lanes; l++)
+            dst[l] = v[l];
+    }
+}
+
+void sos_multi_process(sos_multi_t *m, const float *in, float *out, int count)
+{
+    for (int g = 0; g < m->num_groups; g++) {
+        int first = g * L;
+        float *state = &m->state[(size_t)g * m->num_sos * 4 * L];
+        // Con lanes constante el compilador genera la versión sin condiciones
+        if (m->num_channels - first >= L)
+            process_group(m, state, in, out, count, first, L);
+        else
+            process_group(m, state, in, out, count, first, m->num_channels - first);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SOS_MULTI_H
+#define SOS_MULTI_H
+
+#include <stddef.h>
+#include "dspArena.h"
+
+// -------------------- CASCADA SOS MULTICANAL --------------------
+// La misma cascada de iir_sos_filter aplicada a varios canales a la vez.
+// Una cascada sola es una recurrencia: cada muestra espera a la anterior y
+// no hay nada que paralelizar en el tiempo. Con varios canales, en cambio,
+// cada canal es independiente: se agrupan de a SOS_MULTI_LANES y el estado
+// se guarda por grupo en estructura de arrays ({x1, x2, y1, y2} x carriles),
+// así el lazo interno es la misma ecuación sobre SOS_MULTI_LANES floats
+// contiguos. En el host el compilador lo vectoriza (SSE/AVX/NEON); en el
+// ESP32, que no tiene SIMD de float, igual rinde porque los carriles son
+// cuentas independientes que llenan el pipeline de la FPU en vez de esperar
+// el resultado de la multiplicación anterior.
+//
+// Entrada y salida intercaladas por canal (ch0, ch1, ..., ch0, ch1, ...),
+// como vienen del ADC. Los canales que no completan un grupo se rellenan
+// con ceros, y ese grupo cuesta lo mismo que uno completo o más (en el host
+// no se puede cargar directo en un vector): conviene que num_channels sea
+// múltiplo de SOS_MULTI_LANES, y para 1 o 2 canales usar iir_sos_filter.
+//
+// Los coeficientes tienen el formato de iir_sos_create y se copian
+// normalizados por a0: con a0 = 1 el resultado es idéntico al de
+// iir_sos_filter por canal.
+
+#ifndef SOS_MULTI_LANES
+#define SOS_MULTI_LANES     4       // 4 u 8
+#endif
+
+typedef struct {
+    int num_channels;
+    int num_groups;         // ceil(num_channels / SOS_MULTI_LANES)
+    int num_sos;
+    float *coeffs;          // num_sos x {b0, b1, b2, a1, a2, gain}
+    float *state;           // num_groups x num_sos x {x1, x2, y1, y2} x SOS_MULTI_LANES
+} sos_multi_t;
+
+size_t sos_multi_workspace_size(int num_channels, int num_sos);
+// Devuelve 0 si OK, -1 si algún a0 es 0 o los tamaños no sirven
+int sos_multi_init(sos_multi_t *m, const float *coeffs_x, const float *coeffs_y, const float *gain,
+                   int num_sos, int num_channels, float *workspace);
+sos_multi_t *sos_multi_create(dsp_arena_t *arena, const float *coeffs_x, const float *coeffs_y,
+                              const float *gain, int num_sos, int num_channels);
+void sos_multi_reset(sos_multi_t *m);
+
+// count muestras por canal; in y out pueden ser el mismo buffer
+void sos_multi_process(sos_multi_t *m, const float *in, float *out, int count);
+
+#endif
@@ -0,0 +1,102 @@
+#include <string.h>
+#include <math.h>
+#include "spectralFeatures.h"
+
+static inline float bin_power(const float *s, spectral_format_t format, int k, int half)
+{
+    if (format == SPECTRAL_PACKED) {
+        if (k == 0)
+            return s[0] * s[0];
+        if (k == half)
+            return s[1] * s[1];
+    }
+    return s[2 * k] * s[2 * k] + s[2 * k + 1] * s[2 * k + 1];
+}
+
+void spectral_mag2(const float *spectrum, spectral_format_t format, int fft_size, float *mag2)
+{
+    int half = fft_size / 2;
+    int k = 1;
+
+    mag2[0] = bin_power(spectrum, format, 0, half);
+    // Cuatro bins por vuelta: menos saltos y cargas agrupadas
+    for (; k + 3 < half; k += 4) {
+        const float *s = &spectrum[2 * k];
+        mag2[k]     = s[0] * s[0] + s[1] * s[1];
+        mag2[k + 1] = s[2] * s[2] + s[3] * s[3];
+        mag2[k + 2] = s[4] * s[4] + s[5] * s[5];
+        mag2[k + 3] = s[6] * s[6] + s[7] * s[7];
+    }
+    for (; k <= half; k++)
+        mag2[k] = bin_power(spectrum, format, k, half);
+}
+
+void spectral_to_db(const float *mag2, float *db, int n)
+{
+    for (int i = 0; i < n; i++)
+        db[i] = spectral_fast_db(mag2[i]);
+}
+
+// Inserta el pico en la lista ordenada (de mayor a menor), descartando el último
+static void insert_peak(spectral_features_t *f, int max_peaks, const spectral_peak_t *peak)
+{
+    int i = (f->num_peaks < max_peaks) ? f->num_peaks++ : max_peaks - 1;
+    while (i > 0 && f->peaks[i - 1].power_db < peak->power_db) {
+        f->peaks[i] = f->peaks[i - 1];
+        i--;
+    }
+    f->peaks[i] = *peak;
+}
+
+void spectral_features(const float *spectrum, spectral_format_t format, int fft_size,
+                       float sample_rate_hz, int max_peaks, float *mag2,
+                       spectral_features_t *features)
+{
+    int half = fft_size / 2;
+    float bin_hz = sample_rate_hz / fft_size;
+    if (max_peaks > SPECTRAL_MAX_PEAKS)
+        max_peaks = SPECTRAL_MAX_PEAKS;
+
+    memset(features, 0, sizeof(*features));
+
+    float sum = 0.0f, weighted = 0.0f, parseval = 0.0f;
+    float prev2 = 0.0f, prev1 = 0.0f;
+    // Un pico nuevo tiene que superar al más chico de la lista cuando está llena
+    float floor_power = 0.0f;
+
+    for (int k = 0; k <= half; k++) {
+        float p = bin_power(spectrum, format, k, half);
+        if (mag2)
+            mag2[k] = p;
+
+        sum += p;
+        weighted += p * k;
+        // Espectro de un lado: los bins 1 .. N/2-1 aparecen dos veces
+        parseval += (k == 0 || k == half) ? p : 2.0f * p;
+
+        // ¿k-1 es un máximo local? (sin DC)
+        if (k >= 2 && prev1 > prev2 && prev1 >= p && prev1 > floor_power && max_peaks > 0) {
+            // Parábola sobre el log de las potencias (más exacta que lineal)
+            float a = spectral_fast_log2(prev2 > 1e-30f ? prev2 : 1e-30f);
+            float b = spectral_fast_log2(prev1);
+            float c = spectral_fast_log2(p > 1e-30f ? p : 1e-30f);
+            float den = a - 2.0f * b + c;
+            float delta = (den < 0.0f) ? 0.5f * (a - c) / den : 0.0f;
+
+            spectral_peak_t peak = {
+                .bin = (k - 1) + delta,
+                .freq_hz = ((k - 1) + delta) * bin_hz,
+                .power_db = 3.0103000f * (b - 0.25f * (a - c) * delta),
+            };
+            insert_peak(features, max_peaks, &peak);
+            if (features->num_peaks == max_peaks)
+                floor_power = exp2f(features->peaks[max_peaks - 1].power_db / 3.0103000f);
+        }
+        prev2 = prev1;
+        prev1 = p;
+    }
+
+    features->total_power = sum;
+    features->centroid_hz = (sum > 0.0f) ? weighted / sum * bin_hz : 0.0f;
+    features->rms = sqrtf(parseval) / fft_size;
+}
@@ -0,0 +1,70 @@
+#ifndef SPECTRAL_FEATURES_H
+#define SPECTRAL_FEATURES_H
+
+#include <stdint.h>
+
+// -------------------- DESCRIPTORES ESPECTRALES --------------------
+// Etapa posterior a la FFT de N muestras reales: |X|^2, dB, los K picos más
+// altos con interpolación parabólica (frecuencia con fracción de bin),
+// centroide y RMS. Todo sale de una sola pasada por los bins 0 .. N/2.
+//
+// Formatos de entrada:
+//  - SPECTRAL_COMPLEX: salida de dsps_fft2r_fc32 + dsps_bit_rev2r_fc32 (o
+//    fft_plan_forward) con la señal real en la parte real, N complejos.
+//  - SPECTRAL_PACKED: salida de fft_plan_forward_real (N floats empaquetados).
+
+#define SPECTRAL_MAX_PEAKS      8
+
+typedef enum {
+    SPECTRAL_COMPLEX = 0,
+    SPECTRAL_PACKED  = 1,
+} spectral_format_t;
+
+typedef struct {
+    float bin;              // con fracción
+    float freq_hz;
+    float power_db;         // 10*log10(|X|^2) interpolado
+} spectral_peak_t;
+
+typedef struct {
+    float total_power;      // sum |X|^2 de los bins 0 .. N/2
+    float centroid_hz;
+    float rms;              // RMS de la señal en el tiempo (Parseval)
+    int num_peaks;
+    spectral_peak_t peaks[SPECTRAL_MAX_PEAKS];     // de mayor a menor
+} spectral_features_t;
+
+// -------------------- LOG RÁPIDO --------------------
+// log2(x) = exponente + p(mantisa) con p cúbico ajustado en [1, 2).
+// Error absoluto < 8e-4 en log2, o sea < 0.0025 dB en spectral_fast_db.
+// x debe ser > 0 y normal (no sirve para 0, subnormales, inf ni NaN).
+static inline float spectral_fast_log2(float x)
+{
+    union { float f; uint32_t u; } v = {x};
+    int exponent = (int)((v.u >> 23) & 0xFF) - 127;
+    v.u = (v.u & 0x007FFFFF) | 0x3F800000;      // mantisa en [1, 2)
+    float t = v.f - 1.0f;
+    float p = t * (1.4245946f + t * (-0.5892098f + t * 0.1653866f));
+    return (float)exponent + p;
+}
+
+// 10*log10(power), con piso para power <= 1e-30 (-300 dB)
+static inline float spectral_fast_db(float power)
+{
+    if (power < 1e-30f)
+        power = 1e-30f;
+    return 3.0103000f * spectral_fast_log2(power);
+}
+
+// |X[k]|^2 para k = 0 .. N/2 (N/2 + 1 valores)
+void spectral_mag2(const float *spectrum, spectral_format_t format, int fft_size, float *mag2);
+// dB de n potencias (puede ser in-place)
+void spectral_to_db(const float *mag2, float *db, int n);
+
+// Una pasada: centroide, RMS y hasta max_peaks picos (máximos locales, sin
+// DC ni Nyquist). mag2, si no es NULL, recibe N/2 + 1 valores de |X|^2.
+void spectral_features(const float *spectrum, spectral_format_t format, int fft_size,
+                       float sample_rate_hz, int max_peaks, float *mag2,
+                       spectral_features_t *features);
+
+#endif